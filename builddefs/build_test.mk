@@ -51,10 +51,19 @@ ifeq ($(strip $(DEBUG)), 1)
 CONSOLE_ENABLE = yes
 endif
 
+ifeq ($(strip $(BENCH)), yes)
+# Benchmarks are built with the same optimisation as the firmware
+OPT = s
+endif
+
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include tests/test_common/build.mk
+ifeq ($(strip $(BENCH)), yes)
+include $(TEST_PATH)/bench.mk
+else
 include $(TEST_PATH)/test.mk
 endif
+endif
 
 include $(BUILDDEFS_PATH)/common_features.mk
 include $(BUILDDEFS_PATH)/generic_features.mk
@@ -62,8 +71,10 @@ include $(PLATFORM_PATH)/common.mk
 include $(TMK_PATH)/protocol.mk
 include $(QUANTUM_PATH)/debounce/tests/rules.mk
 include $(QUANTUM_PATH)/encoder/tests/rules.mk
+include $(QUANTUM_PATH)/latency_trace/tests/rules.mk
 include $(QUANTUM_PATH)/os_detection/tests/rules.mk
 include $(QUANTUM_PATH)/sequencer/tests/rules.mk
+include $(QUANTUM_PATH)/split_common/tests/rules.mk
 include $(QUANTUM_PATH)/wear_leveling/tests/rules.mk
 include $(QUANTUM_PATH)/logging/print.mk
 include $(PLATFORM_PATH)/test/rules.mk
@@ -71,8 +82,14 @@ ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include $(BUILDDEFS_PATH)/build_full_test.mk
 endif
 
+ifeq ($(strip $(BENCH)), yes)
+include tests/bench/bench_common/build.mk
+else
+$(TEST_OUTPUT)_SRC += \
+	tests/test_common/main.cpp
+endif
+
 $(TEST_OUTPUT)_SRC += \
-	tests/test_common/main.cpp \
 	$(QUANTUM_PATH)/logging/print.c
 
 ifneq ($(strip $(INTROSPECTION_KEYMAP_C)),)
@@ -35,6 +35,8 @@ GENERIC_FEATURES = \
     HAPTIC \
     KEY_LOCK \
     KEY_OVERRIDE \
+    KEYCODE_CACHE \
+    LATENCY_TRACE \
     LEADER \
     MAGIC \
     MOUSEKEY \
@@ -19,6 +19,143 @@
 
 #include "eeprom_driver.h"
 
+#ifdef EEPROM_WRITE_BACK
+#    include <stdbool.h>
+#    include "eeconfig.h"
+#    include "timer.h"
+
+// Number of bytes, starting at address 0, which are cached in RAM -- by default the eeconfig area
+#    ifndef EEPROM_WRITE_BACK_SIZE
+#        define EEPROM_WRITE_BACK_SIZE (EECONFIG_SIZE)
+#    endif
+
+// Granularity of the dirty tracking, in bytes
+#    ifndef EEPROM_WRITE_BACK_BLOCK_SIZE
+#        define EEPROM_WRITE_BACK_BLOCK_SIZE 8
+#    endif
+
+// How long after the last change the cache is written back, in milliseconds
+#    ifndef EEPROM_WRITE_BACK_FLUSH_TIMEOUT
+#        define EEPROM_WRITE_BACK_FLUSH_TIMEOUT 1000
+#    endif
+
+#    define EEPROM_WRITE_BACK_BLOCKS (((EEPROM_WRITE_BACK_SIZE) + (EEPROM_WRITE_BACK_BLOCK_SIZE)-1) / (EEPROM_WRITE_BACK_BLOCK_SIZE))
+
+static uint8_t  write_back_cache[EEPROM_WRITE_BACK_SIZE];
+static uint8_t  write_back_dirty[(EEPROM_WRITE_BACK_BLOCKS + 7) / 8];
+static bool     write_back_loaded  = false;
+static bool     write_back_pending = false;
+static uint32_t write_back_last_change;
+
+static void write_back_load(void) {
+    eeprom_driver_raw_read_block(write_back_cache, (const void *)0, EEPROM_WRITE_BACK_SIZE);
+    memset(write_back_dirty, 0, sizeof(write_back_dirty));
+    write_back_pending = false;
+    write_back_loaded  = true;
+}
+
+void eeprom_driver_init(void) {
+    eeprom_driver_raw_init();
+    write_back_load();
+}
+
+void eeprom_driver_erase(void) {
+    eeprom_driver_raw_erase();
+    if (write_back_loaded) {
+        write_back_load();
+    }
+}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    uintptr_t offset = (uintptr_t)addr;
+    uint8_t * dest   = buf;
+
+    if (write_back_loaded && offset < (EEPROM_WRITE_BACK_SIZE)) {
+        size_t cached = (EEPROM_WRITE_BACK_SIZE)-offset;
+        if (cached > len) {
+            cached = len;
+        }
+        memcpy(dest, &write_back_cache[offset], cached);
+        dest += cached;
+        offset += cached;
+        len -= cached;
+    }
+
+    if (len > 0) {
+        eeprom_driver_raw_read_block(dest, (const void *)offset, len);
+    }
+}
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    uintptr_t      offset = (uintptr_t)addr;
+    const uint8_t *src    = buf;
+
+    if (write_back_loaded && offset < (EEPROM_WRITE_BACK_SIZE)) {
+        size_t cached = (EEPROM_WRITE_BACK_SIZE)-offset;
+        if (cached > len) {
+            cached = len;
+        }
+        bool changed = false;
+        for (size_t i = 0; i < cached; ++i, ++offset) {
+            if (write_back_cache[offset] != src[i]) {
+                write_back_cache[offset] = src[i];
+                const size_t block       = offset / (EEPROM_WRITE_BACK_BLOCK_SIZE);
+                write_back_dirty[block / 8] |= (1 << (block % 8));
+                changed = true;
+            }
+        }
+        if (changed) {
+            write_back_pending     = true;
+            write_back_last_change = timer_read32();
+        }
+        src += cached;
+        len -= cached;
+    }
+
+    if (len > 0) {
+        eeprom_driver_raw_write_block(src, (void *)offset, len);
+    }
+}
+
+/** \brief Writes every dirty run of blocks back to the driver. */
+void eeprom_driver_flush(void) {
+    if (!write_back_pending) {
+        return;
+    }
+
+    size_t block = 0;
+    while (block < EEPROM_WRITE_BACK_BLOCKS) {
+        if (!(write_back_dirty[block / 8] & (1 << (block % 8)))) {
+            block++;
+            continue;
+        }
+
+        // Adjacent dirty blocks go out as one write
+        const size_t first = block;
+        while (block < EEPROM_WRITE_BACK_BLOCKS && (write_back_dirty[block / 8] & (1 << (block % 8)))) {
+            write_back_dirty[block / 8] &= ~(1 << (block % 8));
+            block++;
+        }
+
+        const size_t start = first * (EEPROM_WRITE_BACK_BLOCK_SIZE);
+        size_t       end   = block * (EEPROM_WRITE_BACK_BLOCK_SIZE);
+        if (end > (EEPROM_WRITE_BACK_SIZE)) {
+            end = (EEPROM_WRITE_BACK_SIZE);
+        }
+        eeprom_driver_raw_write_block(&write_back_cache[start], (void *)start, end - start);
+    }
+
+    write_back_pending = false;
+}
+
+/** \brief Writes the cache back once it has been left alone for EEPROM_WRITE_BACK_FLUSH_TIMEOUT. */
+void eeprom_driver_task(void) {
+    if (write_back_pending && timer_elapsed32(write_back_last_change) >= (EEPROM_WRITE_BACK_FLUSH_TIMEOUT)) {
+        eeprom_driver_flush();
+    }
+}
+#endif // EEPROM_WRITE_BACK
+
 uint8_t eeprom_read_byte(const uint8_t *addr) {
     uint8_t ret = 0;
     eeprom_read_block(&ret, addr, 1);
@@ -20,3 +20,14 @@
 
 void eeprom_driver_init(void);
 void eeprom_driver_erase(void);
+
+#ifdef EEPROM_WRITE_BACK
+void eeprom_driver_task(void);
+void eeprom_driver_flush(void);
+
+/* Implemented by drivers including eeprom_driver_raw.h, and only called by the write-back cache. */
+void eeprom_driver_raw_init(void);
+void eeprom_driver_raw_erase(void);
+void eeprom_driver_raw_read_block(void *buf, const void *addr, size_t len);
+void eeprom_driver_raw_write_block(const void *buf, void *addr, size_t len);
+#endif // EEPROM_WRITE_BACK
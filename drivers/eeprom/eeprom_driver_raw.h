@@ -0,0 +1,30 @@
+/* Copyright 2024 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+/* Only to be included by the EEPROM driver implementations themselves. */
+
+#include "eeprom_driver.h"
+
+#ifdef EEPROM_WRITE_BACK
+/* The write-back cache in eeprom_driver.c provides the public API, so the
+ * driver's implementation is moved behind it under the raw accessor names. */
+#    define eeprom_driver_init eeprom_driver_raw_init
+#    define eeprom_driver_erase eeprom_driver_raw_erase
+#    define eeprom_read_block eeprom_driver_raw_read_block
+#    define eeprom_write_block eeprom_driver_raw_write_block
+#endif // EEPROM_WRITE_BACK
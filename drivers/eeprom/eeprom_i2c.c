@@ -35,7 +35,7 @@
 
 #include "wait.h"
 #include "i2c_master.h"
-#include "eeprom.h"
+#include "eeprom_driver_raw.h"
 #include "eeprom_i2c.h"
 
 // #define DEBUG_EEPROM_OUTPUT
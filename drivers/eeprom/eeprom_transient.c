@@ -17,7 +17,7 @@
 #include <stdint.h>
 #include <string.h>
 
-#include "eeprom_driver.h"
+#include "eeprom_driver_raw.h"
 #include "eeprom_transient.h"
 
 __attribute__((aligned(4))) static uint8_t transientBuffer[TRANSIENT_EEPROM_SIZE] = {0};
@@ -3,7 +3,7 @@
 #include <stdint.h>
 #include <string.h>
 
-#include "eeprom_driver.h"
+#include "eeprom_driver_raw.h"
 #include "wear_leveling.h"
 
 void eeprom_driver_init(void) {
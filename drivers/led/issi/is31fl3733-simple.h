@@ -25,6 +25,10 @@
 #include "progmem.h"
 #include "util.h"
 
+#ifdef ISSI_INCREMENTAL_FLUSH
+#    include "issi_incremental_flush.h"
+#endif
+
 // ======== DEPRECATED DEFINES - DO NOT USE ========
 #ifdef ISSI_TIMEOUT
 #    define IS31FL3733_I2C_TIMEOUT ISSI_TIMEOUT
@@ -25,6 +25,10 @@
 #define IS31FL3733_PWM_REGISTER_COUNT 192
 #define IS31FL3733_LED_CONTROL_REGISTER_COUNT 24
 
+// The PWM buffer is sent in 16 byte chunks, each with its own dirty bit
+#define IS31FL3733_PWM_CHUNK(reg) (1 << ((reg) / 16))
+#define IS31FL3733_PWM_CHUNK_ALL 0x0FFF
+
 #ifndef IS31FL3733_I2C_TIMEOUT
 #    define IS31FL3733_I2C_TIMEOUT 100
 #endif
@@ -71,8 +75,8 @@ uint8_t g_twi_transfer_buffer[20];
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in is31fl3733_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
-uint8_t g_pwm_buffer[IS31FL3733_DRIVER_COUNT][IS31FL3733_PWM_REGISTER_COUNT];
-bool    g_pwm_buffer_update_required[IS31FL3733_DRIVER_COUNT] = {false};
+uint8_t  g_pwm_buffer[IS31FL3733_DRIVER_COUNT][IS31FL3733_PWM_REGISTER_COUNT];
+uint16_t g_pwm_buffer_dirty[IS31FL3733_DRIVER_COUNT] = {0};
 
 uint8_t g_led_control_registers[IS31FL3733_DRIVER_COUNT][IS31FL3733_LED_CONTROL_REGISTER_COUNT] = {0};
 bool    g_led_control_registers_update_required[IS31FL3733_DRIVER_COUNT]                        = {false};
@@ -96,14 +100,17 @@ bool is31fl3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     return true;
 }
 
-bool is31fl3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+static bool is31fl3733_write_pwm_chunks(uint8_t addr, uint8_t *pwm_buffer, uint16_t dirty) {
     // Assumes PG1 is already selected.
     // If any of the transactions fails function returns false.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
+    // Transmit the PWM registers flagged in `dirty`, in transfers of 16 bytes.
     // g_twi_transfer_buffer[] is 20 bytes
 
     // Iterate over the pwm_buffer contents at 16 byte intervals.
     for (int i = 0; i < IS31FL3733_PWM_REGISTER_COUNT; i += 16) {
+        if (!(dirty & IS31FL3733_PWM_CHUNK(i))) {
+            continue;
+        }
         g_twi_transfer_buffer[0] = i;
         // Copy the data from i to i+15.
         // Device will auto-increment register for data after the first byte
@@ -125,6 +132,55 @@ bool is31fl3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     return true;
 }
 
+#ifdef ISSI_INCREMENTAL_FLUSH
+// The PWM buffers are sent a few chunks at a time from the main loop, see issi_incremental_flush.c
+static const uint8_t pwm_tx_addr[IS31FL3733_DRIVER_COUNT] = {
+    IS31FL3733_I2C_ADDRESS_1,
+#    if defined(IS31FL3733_I2C_ADDRESS_2)
+    IS31FL3733_I2C_ADDRESS_2,
+#        if defined(IS31FL3733_I2C_ADDRESS_3)
+    IS31FL3733_I2C_ADDRESS_3,
+#            if defined(IS31FL3733_I2C_ADDRESS_4)
+    IS31FL3733_I2C_ADDRESS_4,
+#            endif
+#        endif
+#    endif
+};
+static uint8_t               pwm_tx_buffer[IS31FL3733_DRIVER_COUNT][IS31FL3733_PWM_REGISTER_COUNT];
+static issi_flush_progress_t pwm_tx_progress[IS31FL3733_DRIVER_COUNT];
+
+static bool is31fl3733_flush_select_page(uint8_t index) {
+    // Unlock the command register and select PG1
+    return is31fl3733_write_register(pwm_tx_addr[index], IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC) && is31fl3733_write_register(pwm_tx_addr[index], IS31FL3733_REG_COMMAND, IS31FL3733_COMMAND_PWM);
+}
+
+static bool is31fl3733_flush_write_chunk(uint8_t index, uint8_t *buffer, uint8_t reg) {
+    return is31fl3733_write_pwm_chunks(pwm_tx_addr[index], buffer, IS31FL3733_PWM_CHUNK(reg));
+}
+
+static void is31fl3733_flush_failed(uint8_t index) {
+    // We risk having written dirty PG0, refresh page 0 just in case.
+    g_led_control_registers_update_required[index] = true;
+}
+
+static const issi_incremental_flush_t pwm_flush = {
+    .driver_count = IS31FL3733_DRIVER_COUNT,
+    .chunk_count  = IS31FL3733_PWM_REGISTER_COUNT / 16,
+    .chunk_size   = 16,
+    .pwm_buffer   = &g_pwm_buffer[0][0],
+    .pwm_dirty    = g_pwm_buffer_dirty,
+    .tx_buffer    = &pwm_tx_buffer[0][0],
+    .progress     = pwm_tx_progress,
+    .select_page  = is31fl3733_flush_select_page,
+    .write_chunk  = is31fl3733_flush_write_chunk,
+    .failed       = is31fl3733_flush_failed,
+};
+#endif
+
+bool is31fl3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    return is31fl3733_write_pwm_chunks(addr, pwm_buffer, IS31FL3733_PWM_CHUNK_ALL);
+}
+
 void is31fl3733_init_drivers(void) {
     i2c_init();
 
@@ -209,10 +265,10 @@ void is31fl3733_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         if (g_pwm_buffer[led.driver][led.r] == red && g_pwm_buffer[led.driver][led.g] == green && g_pwm_buffer[led.driver][led.b] == blue) {
             return;
         }
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        g_pwm_buffer[led.driver][led.r] = red;
+        g_pwm_buffer[led.driver][led.g] = green;
+        g_pwm_buffer[led.driver][led.b] = blue;
+        g_pwm_buffer_dirty[led.driver] |= IS31FL3733_PWM_CHUNK(led.r) | IS31FL3733_PWM_CHUNK(led.g) | IS31FL3733_PWM_CHUNK(led.b);
     }
 }
 
@@ -253,17 +309,18 @@ void is31fl3733_set_led_control_register(uint8_t index, bool red, bool green, bo
 }
 
 void is31fl3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
+    if (g_pwm_buffer_dirty[index]) {
         // Firstly we need to unlock the command register and select PG1.
         is31fl3733_write_register(addr, IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC);
         is31fl3733_write_register(addr, IS31FL3733_REG_COMMAND, IS31FL3733_COMMAND_PWM);
 
+        // Only the chunks which changed since the last update are sent.
         // If any of the transactions fail we risk writing dirty PG0,
         // refresh page 0 just in case.
-        if (!is31fl3733_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+        if (!is31fl3733_write_pwm_chunks(addr, g_pwm_buffer[index], g_pwm_buffer_dirty[index])) {
             g_led_control_registers_update_required[index] = true;
         }
-        g_pwm_buffer_update_required[index] = false;
+        g_pwm_buffer_dirty[index] = 0;
     }
 }
 
@@ -272,22 +329,51 @@ void is31fl3733_update_led_control_registers(uint8_t addr, uint8_t index) {
         // Firstly we need to unlock the command register and select PG0
         is31fl3733_write_register(addr, IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC);
         is31fl3733_write_register(addr, IS31FL3733_REG_COMMAND, IS31FL3733_COMMAND_LED_CONTROL);
-        for (int i = 0; i < IS31FL3733_LED_CONTROL_REGISTER_COUNT; i++) {
-            is31fl3733_write_register(addr, i, g_led_control_registers[index][i]);
+#ifdef ISSI_INCREMENTAL_FLUSH
+        issi_incremental_flush_page_changed(&pwm_flush);
+#endif
+
+        // Write all the control registers in a single transfer, starting at 0x00
+        uint8_t transfer_buffer[IS31FL3733_LED_CONTROL_REGISTER_COUNT + 1];
+        transfer_buffer[0] = 0;
+        memcpy(transfer_buffer + 1, g_led_control_registers[index], IS31FL3733_LED_CONTROL_REGISTER_COUNT);
+
+#if IS31FL3733_I2C_PERSISTENCE > 0
+        for (uint8_t i = 0; i < IS31FL3733_I2C_PERSISTENCE; i++) {
+            if (i2c_transmit(addr << 1, transfer_buffer, sizeof(transfer_buffer), IS31FL3733_I2C_TIMEOUT) != 0) {
+                break;
+            }
         }
+#else
+        i2c_transmit(addr << 1, transfer_buffer, sizeof(transfer_buffer), IS31FL3733_I2C_TIMEOUT);
+#endif
         g_led_control_registers_update_required[index] = false;
     }
 }
 
+#ifdef ISSI_INCREMENTAL_FLUSH
+void issi_incremental_flush_task(void) {
+    issi_incremental_flush_step(&pwm_flush);
+}
+
+void issi_incremental_flush_wait(void) {
+    issi_incremental_flush_finish(&pwm_flush);
+}
+
+void is31fl3733_flush(void) {
+    issi_incremental_flush_frame(&pwm_flush);
+}
+#else
 void is31fl3733_flush(void) {
     is31fl3733_update_pwm_buffers(IS31FL3733_I2C_ADDRESS_1, 0);
-#if defined(IS31FL3733_I2C_ADDRESS_2)
+#    if defined(IS31FL3733_I2C_ADDRESS_2)
     is31fl3733_update_pwm_buffers(IS31FL3733_I2C_ADDRESS_2, 1);
-#    if defined(IS31FL3733_I2C_ADDRESS_3)
+#        if defined(IS31FL3733_I2C_ADDRESS_3)
     is31fl3733_update_pwm_buffers(IS31FL3733_I2C_ADDRESS_3, 2);
-#        if defined(IS31FL3733_I2C_ADDRESS_4)
+#            if defined(IS31FL3733_I2C_ADDRESS_4)
     is31fl3733_update_pwm_buffers(IS31FL3733_I2C_ADDRESS_4, 3);
+#            endif
 #        endif
 #    endif
-#endif
 }
+#endif
@@ -24,6 +24,10 @@
 #include "progmem.h"
 #include "util.h"
 
+#ifdef ISSI_INCREMENTAL_FLUSH
+#    include "issi_incremental_flush.h"
+#endif
+
 // ======== DEPRECATED DEFINES - DO NOT USE ========
 #ifdef DRIVER_ADDR_1
 #    define IS31FL3733_I2C_ADDRESS_1 DRIVER_ADDR_1
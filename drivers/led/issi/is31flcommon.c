@@ -31,13 +31,21 @@
 #    define ISSI_PERSISTENCE 0
 #endif
 
+// The PWM buffer is sent in chunks of ISSI_PWM_TRF_SIZE, each with its own dirty bit
+#define ISSI_PWM_CHUNK_COUNT (ISSI_MAX_LEDS / ISSI_PWM_TRF_SIZE)
+#define ISSI_PWM_CHUNK(reg) (1 << ((reg) / ISSI_PWM_TRF_SIZE))
+
+#if (ISSI_MAX_LEDS % ISSI_PWM_TRF_SIZE) != 0 || ISSI_PWM_CHUNK_COUNT > 16
+#    error ISSI_MAX_LEDS must be a multiple of ISSI_PWM_TRF_SIZE, in at most 16 chunks
+#endif
+
 // Transfer buffer for TWITransmitData()
 uint8_t g_twi_transfer_buffer[20];
 
 // These buffers match the PWM & scaling registers.
 // Storing them like this is optimal for I2C transfers to the registers.
-uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+uint8_t  g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
+uint16_t g_pwm_buffer_dirty[DRIVER_COUNT] = {0};
 
 uint8_t g_scaling_buffer[DRIVER_COUNT][ISSI_SCALING_SIZE];
 bool    g_scaling_buffer_update_required[DRIVER_COUNT] = {false};
@@ -83,10 +91,54 @@ bool IS31FL_write_multi_registers(uint8_t addr, uint8_t *source_buffer, uint8_t
     return true;
 }
 
+#ifdef ISSI_INCREMENTAL_FLUSH
+// The PWM buffers are sent a few chunks at a time from the main loop, see issi_incremental_flush.c
+static const uint8_t pwm_tx_addr[DRIVER_COUNT] = {
+    DRIVER_ADDR_1,
+#    if defined(DRIVER_ADDR_2)
+    DRIVER_ADDR_2,
+#        if defined(DRIVER_ADDR_3)
+    DRIVER_ADDR_3,
+#            if defined(DRIVER_ADDR_4)
+    DRIVER_ADDR_4,
+#            endif
+#        endif
+#    endif
+};
+static uint8_t               pwm_tx_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
+static issi_flush_progress_t pwm_tx_progress[DRIVER_COUNT];
+
+static bool IS31FL_flush_select_page(uint8_t index) {
+    // Not through IS31FL_unlock_register(), which tells the flush that the page changed
+    IS31FL_write_single_register(pwm_tx_addr[index], ISSI_COMMANDREGISTER_WRITELOCK, ISSI_REGISTER_UNLOCK);
+    IS31FL_write_single_register(pwm_tx_addr[index], ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
+    return true;
+}
+
+static bool IS31FL_flush_write_chunk(uint8_t index, uint8_t *buffer, uint8_t reg) {
+    return IS31FL_write_multi_registers(pwm_tx_addr[index], buffer + reg, ISSI_PWM_TRF_SIZE, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST + reg);
+}
+
+static const issi_incremental_flush_t pwm_flush = {
+    .driver_count = DRIVER_COUNT,
+    .chunk_count  = ISSI_PWM_CHUNK_COUNT,
+    .chunk_size   = ISSI_PWM_TRF_SIZE,
+    .pwm_buffer   = &g_pwm_buffer[0][0],
+    .pwm_dirty    = g_pwm_buffer_dirty,
+    .tx_buffer    = &pwm_tx_buffer[0][0],
+    .progress     = pwm_tx_progress,
+    .select_page  = IS31FL_flush_select_page,
+    .write_chunk  = IS31FL_flush_write_chunk,
+};
+#endif
+
 void IS31FL_unlock_register(uint8_t addr, uint8_t page) {
     // unlock the command register and select Page to write
     IS31FL_write_single_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, ISSI_REGISTER_UNLOCK);
     IS31FL_write_single_register(addr, ISSI_COMMANDREGISTER, page);
+#ifdef ISSI_INCREMENTAL_FLUSH
+    issi_incremental_flush_page_changed(&pwm_flush);
+#endif
 }
 
 void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
@@ -120,14 +172,25 @@ void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
     wait_ms(10);
 }
 
+// Sends the chunks of a PWM buffer flagged in `dirty`, stopping at the first failed transfer
+static void IS31FL_write_pwm_chunks(uint8_t addr, uint8_t *pwm_buffer, uint16_t dirty) {
+    // Queue up the correct page
+    IS31FL_unlock_register(addr, ISSI_PAGE_PWM);
+    for (uint8_t i = 0; i < ISSI_MAX_LEDS; i += ISSI_PWM_TRF_SIZE) {
+        if (dirty & ISSI_PWM_CHUNK(i)) {
+            if (!IS31FL_write_multi_registers(addr, pwm_buffer + i, ISSI_PWM_TRF_SIZE, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST + i)) {
+                return;
+            }
+        }
+    }
+}
+
 void IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
-        // Queue up the correct page
-        IS31FL_unlock_register(addr, ISSI_PAGE_PWM);
-        // Hand off the update to IS31FL_write_multi_registers
-        IS31FL_write_multi_registers(addr, g_pwm_buffer[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST);
+    if (g_pwm_buffer_dirty[index]) {
+        // Only the chunks which changed since the last update are sent
+        IS31FL_write_pwm_chunks(addr, g_pwm_buffer[index], g_pwm_buffer_dirty[index]);
         // Update flags that pwm_buffer has been updated
-        g_pwm_buffer_update_required[index] = false;
+        g_pwm_buffer_dirty[index] = 0;
     }
 }
 
@@ -174,18 +237,32 @@ void IS31FL_common_update_scaling_register(uint8_t addr, uint8_t index) {
     }
 }
 
+#ifdef ISSI_INCREMENTAL_FLUSH
+void issi_incremental_flush_task(void) {
+    issi_incremental_flush_step(&pwm_flush);
+}
+
+void issi_incremental_flush_wait(void) {
+    issi_incremental_flush_finish(&pwm_flush);
+}
+
+void IS31FL_common_flush(void) {
+    issi_incremental_flush_frame(&pwm_flush);
+}
+#else
 void IS31FL_common_flush(void) {
     IS31FL_common_update_pwm_register(DRIVER_ADDR_1, 0);
-#if defined(DRIVER_ADDR_2)
+#    if defined(DRIVER_ADDR_2)
     IS31FL_common_update_pwm_register(DRIVER_ADDR_2, 1);
-#    if defined(DRIVER_ADDR_3)
+#        if defined(DRIVER_ADDR_3)
     IS31FL_common_update_pwm_register(DRIVER_ADDR_3, 2);
-#        if defined(DRIVER_ADDR_4)
+#            if defined(DRIVER_ADDR_4)
     IS31FL_common_update_pwm_register(DRIVER_ADDR_4, 3);
+#            endif
 #        endif
 #    endif
-#endif
 }
+#endif
 
 #ifdef RGB_MATRIX_ENABLE
 void IS31FL_RGB_init_drivers(void) {
@@ -229,10 +306,13 @@ void IS31FL_RGB_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         is31_led led;
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        if (g_pwm_buffer[led.driver][led.r] == red && g_pwm_buffer[led.driver][led.g] == green && g_pwm_buffer[led.driver][led.b] == blue) {
+            return;
+        }
+        g_pwm_buffer[led.driver][led.r] = red;
+        g_pwm_buffer[led.driver][led.g] = green;
+        g_pwm_buffer[led.driver][led.b] = blue;
+        g_pwm_buffer_dirty[led.driver] |= ISSI_PWM_CHUNK(led.r) | ISSI_PWM_CHUNK(led.g) | ISSI_PWM_CHUNK(led.b);
     }
 }
 
@@ -317,8 +397,11 @@ void IS31FL_simple_set_brightness(int index, uint8_t value) {
         is31_led led;
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
+        if (g_pwm_buffer[led.driver][led.v] == value) {
+            return;
+        }
         g_pwm_buffer[led.driver][led.v] = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        g_pwm_buffer_dirty[led.driver] |= ISSI_PWM_CHUNK(led.v);
     }
 }
 
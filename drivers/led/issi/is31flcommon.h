@@ -25,6 +25,10 @@
 #include "progmem.h"
 #include "util.h"
 
+#ifdef ISSI_INCREMENTAL_FLUSH
+#    include "issi_incremental_flush.h"
+#endif
+
 // Which variant header file to use
 #if defined(LED_MATRIX_IS31FL3742A) || defined(RGB_MATRIX_IS31FL3742A)
 #    include "is31fl3742.h"
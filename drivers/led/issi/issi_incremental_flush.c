@@ -0,0 +1,107 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "issi_incremental_flush.h"
+
+#ifdef ISSI_INCREMENTAL_FLUSH
+#    include <string.h>
+
+bool issi_incremental_flush_in_progress(const issi_incremental_flush_t *flush) {
+    for (uint8_t i = 0; i < flush->driver_count; i++) {
+        if (flush->progress[i].pending) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Takes a snapshot of the dirty chunks, which issi_incremental_flush_step() then sends, while the PWM buffers keep being rendered into.
+ */
+void issi_incremental_flush_frame(const issi_incremental_flush_t *flush) {
+    // Changes made while the previous frame is being sent stay dirty until the next one
+    if (issi_incremental_flush_in_progress(flush)) {
+        return;
+    }
+
+    const uint16_t buffer_size = flush->chunk_count * flush->chunk_size;
+    for (uint8_t i = 0; i < flush->driver_count; i++) {
+        if (!flush->pwm_dirty[i]) {
+            continue;
+        }
+        for (uint8_t chunk = 0; chunk < flush->chunk_count; chunk++) {
+            if (flush->pwm_dirty[i] & (1 << chunk)) {
+                const uint16_t offset = (i * buffer_size) + (chunk * flush->chunk_size);
+                memcpy(&flush->tx_buffer[offset], &flush->pwm_buffer[offset], flush->chunk_size);
+            }
+        }
+        flush->progress[i].pending       = flush->pwm_dirty[i];
+        flush->progress[i].page_selected = false;
+        flush->pwm_dirty[i]              = 0;
+    }
+}
+
+static void issi_incremental_flush_failed(const issi_incremental_flush_t *flush, uint8_t index) {
+    // Whatever wasn't sent goes out with the next frame, and the page is selected again as its state is unknown
+    flush->pwm_dirty[index] |= flush->progress[index].pending;
+    flush->progress[index].pending       = 0;
+    flush->progress[index].page_selected = false;
+    if (flush->failed) {
+        flush->failed(index);
+    }
+}
+
+/**
+ * Sends up to ISSI_INCREMENTAL_FLUSH_CHUNKS chunks of the frame, selecting the PWM page of each LED driver once per frame.
+ */
+void issi_incremental_flush_step(const issi_incremental_flush_t *flush) {
+    const uint16_t buffer_size = flush->chunk_count * flush->chunk_size;
+    uint8_t        budget      = ISSI_INCREMENTAL_FLUSH_CHUNKS;
+    for (uint8_t i = 0; i < flush->driver_count && budget; i++) {
+        issi_flush_progress_t *progress = &flush->progress[i];
+        if (!progress->pending) {
+            continue;
+        }
+        if (!progress->page_selected) {
+            if (!flush->select_page(i)) {
+                issi_incremental_flush_failed(flush, i);
+                continue;
+            }
+            progress->page_selected = true;
+        }
+        for (uint8_t chunk = 0; chunk < flush->chunk_count && budget; chunk++) {
+            if (!(progress->pending & (1 << chunk))) {
+                continue;
+            }
+            budget--;
+            if (!flush->write_chunk(i, &flush->tx_buffer[i * buffer_size], chunk * flush->chunk_size)) {
+                issi_incremental_flush_failed(flush, i);
+                break;
+            }
+            progress->pending &= ~(1 << chunk);
+        }
+    }
+}
+
+/**
+ * Sends the frame in progress, then anything rendered in the meantime, in one go.
+ */
+void issi_incremental_flush_finish(const issi_incremental_flush_t *flush) {
+    while (issi_incremental_flush_in_progress(flush)) {
+        issi_incremental_flush_step(flush);
+    }
+    issi_incremental_flush_frame(flush);
+    while (issi_incremental_flush_in_progress(flush)) {
+        issi_incremental_flush_step(flush);
+    }
+}
+
+/**
+ * To be called when something else selects another page, so that the PWM page is selected again before the next chunk.
+ */
+void issi_incremental_flush_page_changed(const issi_incremental_flush_t *flush) {
+    for (uint8_t i = 0; i < flush->driver_count; i++) {
+        flush->progress[i].page_selected = false;
+    }
+}
+#endif // ISSI_INCREMENTAL_FLUSH
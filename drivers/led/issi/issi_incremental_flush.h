@@ -0,0 +1,49 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Number of PWM chunks sent per call to issi_incremental_flush_task()
+#ifndef ISSI_INCREMENTAL_FLUSH_CHUNKS
+#    define ISSI_INCREMENTAL_FLUSH_CHUNKS 2
+#endif
+
+/**
+ * Progress of the frame being sent to one LED driver.
+ */
+typedef struct issi_flush_progress_t {
+    uint16_t pending;       // chunks of the snapshot still to be sent
+    bool     page_selected; // whether the PWM page has been selected for this frame
+} issi_flush_progress_t;
+
+/**
+ * The PWM buffers of an ISSI driver, and how to write them to the hardware.
+ *
+ * Every buffer is chunk_count * chunk_size bytes per LED driver, and each bit
+ * of the dirty masks stands for one chunk, which is sent in one transfer.
+ */
+typedef struct issi_incremental_flush_t {
+    uint8_t                driver_count;
+    uint8_t                chunk_count;
+    uint8_t                chunk_size;
+    uint8_t *              pwm_buffer; // rendered into
+    uint16_t *             pwm_dirty;  // chunks of pwm_buffer changed since the last frame
+    uint8_t *              tx_buffer;  // snapshot of the frame being sent
+    issi_flush_progress_t *progress;
+    bool (*select_page)(uint8_t index);
+    bool (*write_chunk)(uint8_t index, uint8_t *buffer, uint8_t reg);
+    void (*failed)(uint8_t index); // optional
+} issi_incremental_flush_t;
+
+bool issi_incremental_flush_in_progress(const issi_incremental_flush_t *flush);
+void issi_incremental_flush_frame(const issi_incremental_flush_t *flush);
+void issi_incremental_flush_step(const issi_incremental_flush_t *flush);
+void issi_incremental_flush_finish(const issi_incremental_flush_t *flush);
+void issi_incremental_flush_page_changed(const issi_incremental_flush_t *flush);
+
+// Implemented by the ISSI driver on top of the above
+void issi_incremental_flush_task(void);
+void issi_incremental_flush_wait(void);
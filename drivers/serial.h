@@ -28,6 +28,13 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+// start a transaction without waiting for it, false while the previous one is still running
+bool soft_serial_transaction_start(int sstd_index);
+// result of the transaction started last, TRANSPORT_ASYNC_DONE and _FAILED are reported once
+transport_async_status_t soft_serial_transaction_poll(void);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
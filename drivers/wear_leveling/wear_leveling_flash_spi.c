@@ -41,6 +41,16 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#if defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION) || WEAR_LEVELING_BANK_COUNT > 1
+size_t backing_store_erase_step_count(void) {
+    return (WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_COUNT);
+}
+
+bool backing_store_erase_step(size_t step) {
+    return flash_erase_block(((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) + step) * (EXTERNAL_FLASH_BLOCK_SIZE)) == FLASH_STATUS_SUCCESS;
+}
+#endif // defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION) || WEAR_LEVELING_BANK_COUNT > 1
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
@@ -30,6 +30,18 @@ uint32_t timer_elapsed32(uint32_t tlast) {
     return TIMER_DIFF_32(timer_read32(), tlast);
 }
 
+uint32_t timer_read_ticks(void) {
+    return timer_read32();
+}
+
+uint32_t timer_ticks_to_us(uint32_t ticks) {
+    return ticks * 1000;
+}
+
+uint32_t timer_ticks_frequency(void) {
+    return 1000;
+}
+
 void timer_clear(void) {
     set_time(0);
 }
@@ -15,5 +15,7 @@
  */
 #pragma once
 
+#include "timer_avr.h"
+
 // The platform is 8-bit, so prefer 16-bit timers to reduce code size
 #define FAST_TIMER_T_SIZE 16
@@ -134,6 +134,41 @@ inline uint32_t timer_elapsed32(uint32_t last) {
     return TIMER_DIFF_32(t, last);
 }
 
+/** \brief timer read ticks
+ *
+ * Combines the millisecond count with the raw Timer0 counter, at TIMER_RAW_FREQ.
+ */
+uint32_t timer_read_ticks(void) {
+    uint32_t ms;
+    uint8_t  raw;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ms  = timer_count;
+        raw = TIMER_RAW;
+#if defined(TIFR0) && defined(OCF0A)
+        // The counter wrapped after interrupts were disabled, timer_count hasn't caught up yet
+        if ((TIFR0 & _BV(OCF0A)) && raw < TIMER_RAW_TOP / 2) {
+            ms++;
+        }
+#endif
+    }
+
+    return ms * (TIMER_RAW_TOP + 1) + raw;
+}
+
+uint32_t timer_ticks_to_us(uint32_t ticks) {
+#if 1000000 % TIMER_RAW_FREQ == 0
+    return ticks * (1000000 / TIMER_RAW_FREQ);
+#else
+    return (uint64_t)ticks * 1000000 / TIMER_RAW_FREQ;
+#endif
+}
+
+uint32_t timer_ticks_frequency(void) {
+    // Timer0 counts up to TIMER_RAW_TOP every millisecond
+    return TIMER_RAW_FREQ;
+}
+
 // excecuted once per 1ms.(excess for just timer count?)
 #ifndef __AVR_ATmega32A__
 #    define TIMER_INTERRUPT_VECTOR TIMER0_COMPA_vect
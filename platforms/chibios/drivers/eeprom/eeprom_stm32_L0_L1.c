@@ -18,7 +18,7 @@
 #include <string.h>
 
 #include <hal.h>
-#include "eeprom_driver.h"
+#include "eeprom_driver_raw.h"
 #include "eeprom_stm32_L0_L1.h"
 
 #define EEPROM_BASE_ADDR 0x08080000
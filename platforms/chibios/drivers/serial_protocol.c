@@ -38,11 +38,40 @@ void soft_serial_target_init(void) {
     chThdCreateStatic(waSlaveThread, sizeof(waSlaveThread), HIGHPRIO, SlaveThread, NULL);
 }
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+static MUTEX_DECL(link_mutex);
+static BSEMAPHORE_DECL(async_start, true);
+static volatile uint8_t                  async_transaction_id;
+static volatile transport_async_status_t async_status = TRANSPORT_ASYNC_IDLE;
+
+/**
+ * @brief This thread runs on the master and carries out the transactions
+ * started with soft_serial_transaction_start(). It sleeps in the driver while
+ * the buffers are moved by the USART interrupts or DMA, so the main loop can
+ * keep scanning its own half in the meantime.
+ */
+static THD_WORKING_AREA(waMasterThread, 512);
+static THD_FUNCTION(MasterThread, arg) {
+    (void)arg;
+    chRegSetThreadName("split_protocol_async");
+
+    while (true) {
+        chBSemWait(&async_start);
+        async_status = soft_serial_transaction(async_transaction_id) ? TRANSPORT_ASYNC_DONE : TRANSPORT_ASYNC_FAILED;
+    }
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
 /**
  * @brief Master specific initializations.
  */
 void soft_serial_initiator_init(void) {
     serial_transport_driver_master_init();
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+    /* Start transport thread. */
+    chThdCreateStatic(waMasterThread, sizeof(waMasterThread), HIGHPRIO, MasterThread, NULL);
+#endif // SPLIT_TRANSPORT_ASYNC
 }
 
 /**
@@ -100,12 +129,55 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#ifdef SPLIT_TRANSPORT_ASYNC
+    /* Wait for the transaction running in the background, if any. */
+    chMtxLock(&link_mutex);
+#endif // SPLIT_TRANSPORT_ASYNC
+
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
 
-    return initiate_transaction((uint8_t)index);
+    bool success = initiate_transaction((uint8_t)index);
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+    chMtxUnlock(&link_mutex);
+#endif // SPLIT_TRANSPORT_ASYNC
+
+    return success;
+}
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+/**
+ * @brief Start transaction from the master half to the slave half, without
+ * waiting for it to complete.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool false if the previous transaction is still running.
+ */
+bool soft_serial_transaction_start(int index) {
+    if (async_status == TRANSPORT_ASYNC_BUSY) {
+        return false;
+    }
+
+    async_transaction_id = (uint8_t)index;
+    async_status         = TRANSPORT_ASYNC_BUSY;
+    chBSemSignal(&async_start);
+    return true;
+}
+
+/**
+ * @brief Result of the transaction started last. Completion and failure are
+ * only reported once, after which the transport is idle again.
+ */
+transport_async_status_t soft_serial_transaction_poll(void) {
+    transport_async_status_t status = async_status;
+    if (status != TRANSPORT_ASYNC_BUSY) {
+        async_status = TRANSPORT_ASYNC_IDLE;
+    }
+    return status;
 }
+#endif // SPLIT_TRANSPORT_ASYNC
 
 /**
  * @brief Initiate transaction to slave half.
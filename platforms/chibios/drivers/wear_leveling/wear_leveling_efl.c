@@ -3,9 +3,14 @@
 #include <stdbool.h>
 #include <hal.h>
 #include "timer.h"
+#include "util.h"
 #include "wear_leveling.h"
 #include "wear_leveling_internal.h"
 
+#ifndef WEAR_LEVELING_EFL_BULK_COUNT
+#    define WEAR_LEVELING_EFL_BULK_COUNT 32
+#endif // WEAR_LEVELING_EFL_BULK_COUNT
+
 static flash_offset_t base_offset = UINT32_MAX;
 
 #if defined(WEAR_LEVELING_EFL_FIRST_SECTOR)
@@ -120,6 +125,22 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#if defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION) || WEAR_LEVELING_BANK_COUNT > 1
+size_t backing_store_erase_step_count(void) {
+    return sector_count;
+}
+
+bool backing_store_erase_step(size_t step) {
+    flash_error_t status = flashStartEraseSector(flash, first_sector + step);
+    if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+        return false;
+    }
+
+    status = flashWaitErase(flash);
+    return status == FLASH_NO_ERROR || status == FLASH_BUSY_ERASING;
+}
+#endif // defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION) || WEAR_LEVELING_BANK_COUNT > 1
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
@@ -128,6 +149,28 @@ bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return flashProgram(flash, offset, sizeof(value), (const uint8_t *)&value) == FLASH_NO_ERROR;
 }
 
+bool backing_store_write_bulk(uint32_t address, backing_store_int_t *values, size_t item_count) {
+    static backing_store_int_t bulk_write_buffer[WEAR_LEVELING_EFL_BULK_COUNT];
+
+    uint32_t offset = (base_offset + address);
+    bs_dprintf("Write ");
+    wl_dump(offset, values, sizeof(backing_store_int_t) * item_count);
+    while (item_count) {
+        // Flash stores the complement, so stage it in RAM and program a whole batch of lines at once
+        size_t batch_size = MIN(item_count, WEAR_LEVELING_EFL_BULK_COUNT);
+        for (size_t i = 0; i < batch_size; i++) {
+            bulk_write_buffer[i] = ~values[i];
+        }
+        if (flashProgram(flash, offset, batch_size * sizeof(backing_store_int_t), (const uint8_t *)bulk_write_buffer) != FLASH_NO_ERROR) {
+            return false;
+        }
+        offset += batch_size * sizeof(backing_store_int_t);
+        values += batch_size;
+        item_count -= batch_size;
+    }
+    return true;
+}
+
 bool backing_store_lock(void) {
     bs_dprintf("Lock  \n");
     eflStop(&EFLD1);
@@ -162,6 +205,28 @@ bool backing_store_read(uint32_t address, backing_store_int_t *value) {
     return true;
 }
 
+bool backing_store_read_bulk(uint32_t address, backing_store_int_t *values, size_t item_count) {
+    uint32_t             offset = (base_offset + address);
+    backing_store_int_t *loc    = (backing_store_int_t *)flashGetOffsetAddress(flash, offset);
+
+    is_issuing_read    = true;
+    ecc_error_occurred = false;
+    for (size_t i = 0; i < item_count; ++i) {
+        values[i] = ~loc[i];
+    }
+    is_issuing_read = false;
+
+    if (ecc_error_occurred) {
+        bs_dprintf("Failed to read from backing store, ECC error detected\n");
+        ecc_error_occurred = false;
+        return false;
+    }
+
+    bs_dprintf("Read  ");
+    wl_dump(offset, values, item_count * sizeof(backing_store_int_t));
+    return true;
+}
+
 bool backing_store_allow_ecc_errors(void) {
     return is_issuing_read;
 }
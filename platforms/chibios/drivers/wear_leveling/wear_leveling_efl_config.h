@@ -52,3 +52,6 @@
 #ifndef WEAR_LEVELING_LOGICAL_SIZE
 #    define WEAR_LEVELING_LOGICAL_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
 #endif // WEAR_LEVELING_LOGICAL_SIZE
+
+// backing_store_erase_step() erases a single sector at a time
+#define BACKING_STORE_ERASE_STEP_SUPPORTED
@@ -17,8 +17,9 @@
 #include "wear_leveling.h"
 #include "wear_leveling_internal.h"
 
+// A page program can't cross a page boundary, so the staging buffer never needs to be larger than a page
 #ifndef WEAR_LEVELING_RP2040_FLASH_BULK_COUNT
-#    define WEAR_LEVELING_RP2040_FLASH_BULK_COUNT 64
+#    define WEAR_LEVELING_RP2040_FLASH_BULK_COUNT ((FLASH_PAGE_SIZE) / sizeof(backing_store_int_t))
 #endif // WEAR_LEVELING_RP2040_FLASH_BULK_COUNT
 
 #define FLASHCMD_PAGE_PROGRAM 0x02
@@ -133,25 +134,27 @@ static void __no_inline_not_in_flash_func(pico_program_bulk)(uint32_t flash_addr
 
     static backing_store_int_t bulk_write_buffer[WEAR_LEVELING_RP2040_FLASH_BULK_COUNT];
 
+    connect_internal_flash();
+    flash_exit_xip();
+
     while (item_count) {
-        size_t batch_size = MIN(item_count, WEAR_LEVELING_RP2040_FLASH_BULK_COUNT);
+        // Programming wraps around within a page, so batches stop at the end of the current one
+        size_t page_remaining = ((FLASH_PAGE_SIZE) - (flash_address % (FLASH_PAGE_SIZE))) / sizeof(backing_store_int_t);
+        size_t batch_size     = MIN(MIN(item_count, WEAR_LEVELING_RP2040_FLASH_BULK_COUNT), page_remaining);
         for (size_t i = 0; i < batch_size; i++, values++, item_count--) {
             bulk_write_buffer[i] = ~(*values);
         }
         __compiler_memory_barrier();
 
-        connect_internal_flash();
-        flash_exit_xip();
         flash_enable_write();
-
         flash_put_cmd_addr(FLASHCMD_PAGE_PROGRAM, flash_address);
         flash_put_get((uint8_t *)bulk_write_buffer, NULL, batch_size * sizeof(backing_store_int_t), 4);
         flash_wait_ready();
         flash_address += batch_size * sizeof(backing_store_int_t);
-
-        flash_flush_cache();
-        flash_enable_xip_via_boot2();
     }
+
+    flash_flush_cache();
+    flash_enable_xip_via_boot2();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -187,6 +190,19 @@ bool backing_store_erase(void) {
     return true;
 }
 
+#if defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION) || WEAR_LEVELING_BANK_COUNT > 1
+size_t backing_store_erase_step_count(void) {
+    return (WEAR_LEVELING_BACKING_SIZE) / (FLASH_SECTOR_SIZE);
+}
+
+bool backing_store_erase_step(size_t step) {
+    interrupts = save_and_disable_interrupts();
+    flash_range_erase((WEAR_LEVELING_RP2040_FLASH_BASE) + (step * (FLASH_SECTOR_SIZE)), (FLASH_SECTOR_SIZE));
+    restore_interrupts(interrupts);
+    return true;
+}
+#endif // defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION) || WEAR_LEVELING_BANK_COUNT > 1
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
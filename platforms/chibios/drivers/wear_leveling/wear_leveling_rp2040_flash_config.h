@@ -30,3 +30,6 @@
 #ifndef WEAR_LEVELING_RP2040_FLASH_BASE
 #    define WEAR_LEVELING_RP2040_FLASH_BASE ((WEAR_LEVELING_RP2040_FLASH_SIZE) - (WEAR_LEVELING_BACKING_SIZE))
 #endif
+
+// backing_store_erase_step() erases a single sector at a time
+#define BACKING_STORE_ERASE_STEP_SUPPORTED
@@ -1,3 +1,4 @@
+#include <string.h>
 #include "ws2812.h"
 #include "gpio.h"
 #include "util.h"
@@ -86,57 +87,81 @@
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+#if defined(WS2812_SPI_USE_CIRCULAR_BUFFER) || defined(WS2812_SPI_SYNC)
+#    define WS2812_SPI_BUFFER_COUNT 1
+#else
+// A frame is encoded into one buffer while the previous one is still being sent from the other
+#    define WS2812_SPI_BUFFER_COUNT 2
+#endif
+
+static uint8_t txbuf[WS2812_SPI_BUFFER_COUNT][PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+// The colours currently encoded into each buffer, so unchanged LEDs don't need to be encoded again
+static rgb_led_t txbuf_leds[WS2812_SPI_BUFFER_COUNT][WS2812_LED_COUNT] = {0};
+
+#if WS2812_SPI_BUFFER_COUNT > 1
+static volatile uint8_t tx_front   = 0;     // The buffer being sent, or sent last
+static volatile bool    tx_busy    = false; // A transfer is in progress
+static volatile bool    tx_pending = false; // The other buffer is to be sent once the transfer completes
+#endif
 
 /*
  * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
+ * the ws2812b protocol, we use this lookup table to translate bytes into
+ * 0s and 1s for the LED (with the appropriate timing). Each pair of bits,
+ * MSB first, becomes one SPI byte.
  */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+#define WS2812_SPI_SYMBOL(bits) ((((bits)&2) ? 0b11100000 : 0b10000000) | (((bits)&1) ? 0b1110 : 0b1000))
+#define WS2812_SPI_ENCODE(data) \
+    { WS2812_SPI_SYMBOL((data) >> 6), WS2812_SPI_SYMBOL((data) >> 4), WS2812_SPI_SYMBOL((data) >> 2), WS2812_SPI_SYMBOL(data) }
+#define WS2812_SPI_ENCODE_4(data) WS2812_SPI_ENCODE(data), WS2812_SPI_ENCODE((data) + 1), WS2812_SPI_ENCODE((data) + 2), WS2812_SPI_ENCODE((data) + 3)
+#define WS2812_SPI_ENCODE_16(data) WS2812_SPI_ENCODE_4(data), WS2812_SPI_ENCODE_4((data) + 4), WS2812_SPI_ENCODE_4((data) + 8), WS2812_SPI_ENCODE_4((data) + 12)
+#define WS2812_SPI_ENCODE_64(data) WS2812_SPI_ENCODE_16(data), WS2812_SPI_ENCODE_16((data) + 16), WS2812_SPI_ENCODE_16((data) + 32), WS2812_SPI_ENCODE_16((data) + 48)
+
+static const uint8_t protocol_eq[256][BYTES_FOR_LED_BYTE] = {WS2812_SPI_ENCODE_64(0), WS2812_SPI_ENCODE_64(64), WS2812_SPI_ENCODE_64(128), WS2812_SPI_ENCODE_64(192)};
+
+static inline void set_led_byte(uint8_t* tx_start, uint8_t data) {
+    memcpy(tx_start, protocol_eq[data], BYTES_FOR_LED_BYTE);
 }
 
-static void set_led_color_rgb(rgb_led_t color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
+static void set_led_color_rgb(uint8_t* buf, rgb_led_t color, int pos) {
+    uint8_t* tx_start = &buf[PREAMBLE_SIZE + BYTES_FOR_LED * pos];
 
 #if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    set_led_byte(tx_start, color.g);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE, color.r);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE * 2, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
+    set_led_byte(tx_start, color.r);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE, color.g);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE * 2, color.b);
 #elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+    set_led_byte(tx_start, color.b);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE, color.g);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE * 2, color.r);
 #endif
 #ifdef RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 4 + j] = get_protocol_eq(color.w, j);
+    set_led_byte(tx_start + BYTES_FOR_LED_BYTE * 3, color.w);
 #endif
 }
 
+#if WS2812_SPI_BUFFER_COUNT > 1
+// Called from the DMA interrupt once a frame has been sent, starts the next one if there is any
+static void ws2812_spi_complete(SPIDriver* spip) {
+    chSysLockFromISR();
+    if (tx_pending) {
+        tx_pending = false;
+        tx_front ^= 1;
+        spiStartSendI(spip, sizeof(txbuf[0]), txbuf[tx_front]);
+    } else {
+        tx_busy = false;
+    }
+    chSysUnlockFromISR();
+}
+#    define WS2812_SPI_COMPLETE_CB ws2812_spi_complete
+#else
+#    define WS2812_SPI_COMPLETE_CB NULL
+#endif
+
 void ws2812_init(void) {
     palSetLineMode(WS2812_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
 
@@ -151,7 +176,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
-        NULL, // end_cb
+        WS2812_SPI_COMPLETE_CB, // end_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -170,7 +195,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
-        NULL, // data_cb
+        WS2812_SPI_COMPLETE_CB, // data_cb
         NULL, // error_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
@@ -182,29 +207,66 @@ void ws2812_init(void) {
     spiAcquireBus(&WS2812_SPI_DRIVER);     /* Acquire ownership of the bus.    */
     spiStart(&WS2812_SPI_DRIVER, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI_DRIVER);         /* Slave Select assertion.          */
+
+    // Start out with every LED off, which is what txbuf_leds holds
+    for (uint8_t b = 0; b < WS2812_SPI_BUFFER_COUNT; b++) {
+        for (uint16_t i = 0; i < WS2812_LED_COUNT; i++) {
+            set_led_color_rgb(txbuf[b], txbuf_leds[b][i], i);
+        }
+    }
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[0]);
 #endif
 }
 
 void ws2812_setleds(rgb_led_t* ledarray, uint16_t leds) {
     static bool s_init = false;
+    bool        changed = false;
     if (!s_init) {
         ws2812_init();
-        s_init = true;
+        s_init  = true;
+        changed = true;
     }
 
-    for (uint8_t i = 0; i < leds; i++) {
-        set_led_color_rgb(ledarray[i], i);
+#if WS2812_SPI_BUFFER_COUNT > 1
+    // Take back a frame that is still waiting to be sent, as it is about to be replaced by this one
+    chSysLock();
+    tx_pending    = false;
+    uint8_t front = tx_front;
+    chSysUnlock();
+    uint8_t back = front ^ 1;
+#else
+    uint8_t front = 0, back = 0;
+#endif
+
+    for (uint16_t i = 0; i < leds; i++) {
+        if (memcmp(&ledarray[i], &txbuf_leds[front][i], sizeof(rgb_led_t)) != 0) {
+            changed = true;
+        }
+        if (memcmp(&ledarray[i], &txbuf_leds[back][i], sizeof(rgb_led_t)) != 0) {
+            set_led_color_rgb(txbuf[back], ledarray[i], i);
+            txbuf_leds[back][i] = ledarray[i];
+        }
     }
 
-    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
-    // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
-#ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
-#    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
-#    else
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
-#    endif
+    // The LEDs already show, or are being sent, this frame
+    if (!changed) {
+        return;
+    }
+
+#if WS2812_SPI_BUFFER_COUNT > 1
+    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms. Frames flushed faster than that are queued
+    // in the back buffer, and only the latest one is sent once the current transfer completes.
+    chSysLock();
+    if (tx_busy) {
+        tx_pending = true;
+    } else {
+        tx_front = back;
+        tx_busy  = true;
+        spiStartSendI(&WS2812_SPI_DRIVER, sizeof(txbuf[0]), txbuf[back]);
+    }
+    chSysUnlock();
+#elif defined(WS2812_SPI_SYNC)
+    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[0]);
 #endif
 }
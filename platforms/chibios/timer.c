@@ -1,4 +1,6 @@
 #include <ch.h>
+#include <hal.h>
+#include "chibios_config.h"
 
 #include "timer.h"
 
@@ -105,3 +107,31 @@ uint16_t timer_elapsed(uint16_t last) {
 uint32_t timer_elapsed32(uint32_t last) {
     return TIMER_DIFF_32(timer_read32(), last);
 }
+
+// The realtime counter is the cycle counter on ARMv7-M and the 1MHz timer on RP2040, ARMv6-M cores don't have one
+#if PORT_SUPPORTS_RT == TRUE && defined(CPU_CLOCK)
+uint32_t timer_read_ticks(void) {
+    return chSysGetRealtimeCounterX();
+}
+
+uint32_t timer_ticks_to_us(uint32_t ticks) {
+    // The clock isn't always a whole number of MHz
+    return (uint64_t)ticks * 1000000 / REALTIME_COUNTER_CLOCK;
+}
+
+uint32_t timer_ticks_frequency(void) {
+    return REALTIME_COUNTER_CLOCK;
+}
+#else
+uint32_t timer_read_ticks(void) {
+    return timer_read32();
+}
+
+uint32_t timer_ticks_to_us(uint32_t ticks) {
+    return ticks * 1000;
+}
+
+uint32_t timer_ticks_frequency(void) {
+    return 1000;
+}
+#endif
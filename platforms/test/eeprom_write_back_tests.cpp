@@ -0,0 +1,141 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "eeprom_driver.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+struct raw_write {
+    uintptr_t address;
+    size_t    length;
+};
+
+uint8_t                backing[TOTAL_EEPROM_BYTE_COUNT];
+std::vector<raw_write> raw_writes;
+} // namespace
+
+// Mock driver behind the write-back cache
+extern "C" void eeprom_driver_raw_init(void) {}
+
+extern "C" void eeprom_driver_raw_erase(void) {
+    memset(backing, 0, sizeof(backing));
+}
+
+extern "C" void eeprom_driver_raw_read_block(void *buf, const void *addr, size_t len) {
+    memcpy(buf, &backing[(uintptr_t)addr], len);
+}
+
+extern "C" void eeprom_driver_raw_write_block(const void *buf, void *addr, size_t len) {
+    memcpy(&backing[(uintptr_t)addr], buf, len);
+    raw_writes.push_back({(uintptr_t)addr, len});
+}
+
+class EepromWriteBack : public testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        memset(backing, 0, sizeof(backing));
+        backing[1] = 0x42;
+        eeprom_driver_init();
+        raw_writes.clear();
+    }
+};
+
+TEST_F(EepromWriteBack, ReadsComeFromTheCache) {
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)1), 0x42);
+
+    eeprom_update_byte((uint8_t *)1, 0x17);
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)1), 0x17);
+    EXPECT_EQ(backing[1], 0x42);
+    EXPECT_TRUE(raw_writes.empty());
+}
+
+TEST_F(EepromWriteBack, ChangesAreWrittenBackAfterTheTimeout) {
+    eeprom_update_dword((uint32_t *)8, 0xDEADBEEF);
+
+    advance_time(EEPROM_WRITE_BACK_FLUSH_TIMEOUT - 1);
+    eeprom_driver_task();
+    EXPECT_TRUE(raw_writes.empty());
+
+    advance_time(1);
+    eeprom_driver_task();
+    ASSERT_EQ(raw_writes.size(), 1u);
+    EXPECT_EQ(raw_writes[0].address, 8u);
+    EXPECT_EQ(raw_writes[0].length, (size_t)EEPROM_WRITE_BACK_BLOCK_SIZE);
+
+    uint32_t value;
+    memcpy(&value, &backing[8], sizeof(value));
+    EXPECT_EQ(value, 0xDEADBEEF);
+}
+
+TEST_F(EepromWriteBack, RepeatedChangesAreCoalesced) {
+    for (int i = 0; i < 100; i++) {
+        eeprom_update_byte((uint8_t *)4, i);
+        eeprom_update_byte((uint8_t *)5, i * 3);
+        advance_time(EEPROM_WRITE_BACK_FLUSH_TIMEOUT / 2);
+        eeprom_driver_task();
+    }
+    EXPECT_TRUE(raw_writes.empty());
+
+    advance_time(EEPROM_WRITE_BACK_FLUSH_TIMEOUT);
+    eeprom_driver_task();
+    ASSERT_EQ(raw_writes.size(), 1u);
+    EXPECT_EQ(backing[4], 99);
+    EXPECT_EQ(backing[5], (uint8_t)(99 * 3));
+}
+
+TEST_F(EepromWriteBack, AdjacentDirtyBlocksAreWrittenTogether) {
+    uint8_t data[EEPROM_WRITE_BACK_BLOCK_SIZE + 2] = {1, 2, 3, 4, 5, 6};
+    eeprom_update_block(data, (void *)(EEPROM_WRITE_BACK_BLOCK_SIZE - 1), sizeof(data));
+    eeprom_update_byte((uint8_t *)(EEPROM_WRITE_BACK_BLOCK_SIZE * 4), 0x99);
+
+    eeprom_driver_flush();
+    ASSERT_EQ(raw_writes.size(), 2u);
+    EXPECT_EQ(raw_writes[0].address, 0u);
+    EXPECT_EQ(raw_writes[0].length, (size_t)EEPROM_WRITE_BACK_BLOCK_SIZE * 3);
+    EXPECT_EQ(raw_writes[1].address, (uintptr_t)EEPROM_WRITE_BACK_BLOCK_SIZE * 4);
+    EXPECT_EQ(memcmp(&backing[EEPROM_WRITE_BACK_BLOCK_SIZE - 1], data, sizeof(data)), 0);
+
+    eeprom_driver_flush();
+    EXPECT_EQ(raw_writes.size(), 2u);
+}
+
+TEST_F(EepromWriteBack, UnchangedWritesAreDropped) {
+    eeprom_write_byte((uint8_t *)1, 0x42);
+    eeprom_driver_flush();
+    EXPECT_TRUE(raw_writes.empty());
+}
+
+TEST_F(EepromWriteBack, WritesPastTheCacheGoStraightThrough) {
+    uint8_t data[4] = {9, 8, 7, 6};
+    eeprom_write_block(data, (void *)(EEPROM_WRITE_BACK_SIZE - 2), sizeof(data));
+
+    ASSERT_EQ(raw_writes.size(), 1u);
+    EXPECT_EQ(raw_writes[0].address, (uintptr_t)EEPROM_WRITE_BACK_SIZE);
+    EXPECT_EQ(raw_writes[0].length, 2u);
+
+    uint8_t readback[4];
+    eeprom_read_block(readback, (const void *)(EEPROM_WRITE_BACK_SIZE - 2), sizeof(readback));
+    EXPECT_EQ(memcmp(readback, data, sizeof(data)), 0);
+
+    eeprom_driver_flush();
+    EXPECT_EQ(memcmp(&backing[EEPROM_WRITE_BACK_SIZE - 2], data, sizeof(data)), 0);
+}
+
+TEST_F(EepromWriteBack, EraseDropsPendingChanges) {
+    eeprom_update_byte((uint8_t *)2, 0x55);
+    eeprom_driver_erase();
+
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)1), 0);
+    EXPECT_EQ(eeprom_read_byte((const uint8_t *)2), 0);
+    eeprom_driver_flush();
+    EXPECT_TRUE(raw_writes.empty());
+}
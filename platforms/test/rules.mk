@@ -23,3 +23,16 @@ eeprom_legacy_emulated_flash_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_legacy_emulated_flash.c
 eeprom_legacy_emulated_flash_tiny_SRC := $(eeprom_legacy_emulated_flash_SRC)
 eeprom_legacy_emulated_flash_large_SRC := $(eeprom_legacy_emulated_flash_SRC)
+
+eeprom_write_back_DEFS := \
+	-DEEPROM_TEST_HARNESS \
+	-DEEPROM_DRIVER \
+	-DEEPROM_WRITE_BACK \
+	-DEEPROM_WRITE_BACK_SIZE=24 \
+	-DEEPROM_WRITE_BACK_BLOCK_SIZE=4 \
+	-DEEPROM_WRITE_BACK_FLUSH_TIMEOUT=100
+
+eeprom_write_back_SRC := \
+	$(TOP_DIR)/drivers/eeprom/eeprom_driver.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_write_back_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -68,6 +68,18 @@ uint32_t timer_elapsed32(uint32_t last) {
     return TIMER_DIFF_32(timer_read32(), last);
 }
 
+uint32_t timer_read_ticks(void) {
+    return timer_read32();
+}
+
+uint32_t timer_ticks_to_us(uint32_t ticks) {
+    return ticks * 1000;
+}
+
+uint32_t timer_ticks_frequency(void) {
+    return 1000;
+}
+
 void set_time(uint32_t t) {
     current_time   = t;
     access_counter = 0;
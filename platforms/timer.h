@@ -43,6 +43,13 @@ uint32_t timer_read32(void);
 uint16_t timer_elapsed(uint16_t last);
 uint32_t timer_elapsed32(uint32_t last);
 
+// The tick counter wraps around at UINT32_MAX, so only the difference of two readings is meaningful
+uint32_t timer_read_ticks(void);
+// Converts the difference of two timer_read_ticks() readings to microseconds
+uint32_t timer_ticks_to_us(uint32_t ticks);
+// Ticks per second, 1000 on platforms without a counter finer than milliseconds
+uint32_t timer_ticks_frequency(void);
+
 // Utility functions to check if a future time has expired & autmatically handle time wrapping if checked / reset frequently (half of max value)
 #define timer_expired(current, future) ((uint16_t)(current - future) < UINT16_MAX / 2)
 #define timer_expired32(current, future) ((uint32_t)(current - future) < UINT32_MAX / 2)
@@ -63,9 +63,11 @@ static keyrecord_t tapping_key                         = {};
 static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
+static uint16_t    waiting_buffer_overflows            = 0;
 
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_process(void);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
@@ -86,11 +88,35 @@ void action_tapping_process(keyrecord_t record) {
         }
     } else {
         if (!waiting_buffer_enq(record)) {
-            // clear all in case of overflow.
-            ac_dprintf("OVERFLOW: CLEAR ALL STATES\n");
-            clear_keyboard();
-            waiting_buffer_clear();
-            tapping_key = (keyrecord_t){0};
+            if (waiting_buffer_overflows < UINT16_MAX) {
+                waiting_buffer_overflows++;
+            }
+
+            do {
+                // This event may have settled the tapping key already, letting the queue drain
+                const uint8_t tail = waiting_buffer_tail;
+                waiting_buffer_process();
+                if (waiting_buffer_tail != tail) {
+                    continue;
+                }
+
+                if (!IS_NOEVENT(tapping_key.event) && tapping_key.event.pressed && tapping_key.tap.count == 0) {
+                    // Make room by settling the pending tap-hold key as held, as if
+                    // TAPPING_TERM had passed, rather than dropping key events.
+                    ac_dprintf("OVERFLOW: FORCE HOLD\n");
+                    process_record(&tapping_key);
+                    tapping_key = (keyrecord_t){0};
+                    debug_tapping_key();
+                    waiting_buffer_process();
+                } else {
+                    // clear all in case of overflow.
+                    ac_dprintf("OVERFLOW: CLEAR ALL STATES\n");
+                    clear_keyboard();
+                    waiting_buffer_clear();
+                    tapping_key = (keyrecord_t){0};
+                    break;
+                }
+            } while (!waiting_buffer_enq(record));
         }
     }
 
@@ -98,20 +124,20 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
-        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
-            ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
-            debug_record(waiting_buffer[waiting_buffer_tail]);
-            ac_dprintf("\n\n");
-        } else {
-            break;
-        }
-    }
+    waiting_buffer_process();
     if (IS_EVENT(record.event)) {
         ac_dprintf("\n");
     }
 }
 
+/** \brief Number of times a key event didn't fit into the waiting buffer
+ *
+ * Counts up to UINT16_MAX, and is never reset.
+ */
+uint16_t get_waiting_buffer_overflows(void) {
+    return waiting_buffer_overflows;
+}
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
@@ -432,6 +458,23 @@ bool process_tapping(keyrecord_t *keyp) {
     }
 }
 
+/** \brief Waiting buffer process
+ *
+ * Feeds queued events back into the tapping state machine, oldest first,
+ * until one of them has to wait again.
+ */
+void waiting_buffer_process(void) {
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
+            ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
+            debug_record(waiting_buffer[waiting_buffer_tail]);
+            ac_dprintf("\n\n");
+        } else {
+            break;
+        }
+    }
+}
+
 /** \brief Waiting buffer enq
  *
  * FIXME: Needs docs
@@ -32,12 +32,19 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define TAPPING_TOGGLE 5
 #endif
 
-#define WAITING_BUFFER_SIZE 8
+/* number of key events that can queue up behind an undecided tap-hold key */
+#ifndef WAITING_BUFFER_SIZE
+#    define WAITING_BUFFER_SIZE 8
+#endif
+#if WAITING_BUFFER_SIZE < 2 || WAITING_BUFFER_SIZE > 255
+#    error "WAITING_BUFFER_SIZE must be between 2 and 255"
+#endif
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
 uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache);
 void     action_tapping_process(keyrecord_t record);
+uint16_t get_waiting_buffer_overflows(void);
 #endif
 
 uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record);
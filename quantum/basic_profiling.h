@@ -19,6 +19,9 @@
         PROFILE_CALL_NAMED(1000, "matrix_task", {
             matrix_task();
         });
+
+    For percentiles of the main keyboard loop stages rather than averages, see
+    LATENCY_TRACE_ENABLE and latency_trace.h.
 */
 
 #if defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
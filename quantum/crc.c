@@ -43,9 +43,9 @@ static const crc_t crc_table[256] = {
     0xde, 0xd9, 0xd0, 0xd7, 0xc2, 0xc5, 0xcc, 0xcb, 0xe6, 0xe1, 0xe8, 0xef, 0xfa, 0xfd, 0xf4, 0xf3  //
 };
 
-__attribute__((weak)) uint8_t crc8(const void *data, size_t data_len) {
+uint8_t crc8_update(uint8_t seed, const void *data, size_t data_len) {
     const uint8_t *d   = (const uint8_t *)data;
-    crc_t          crc = 0xff;
+    crc_t          crc = seed;
     size_t         tbl_idx;
 
     while (data_len--) {
@@ -56,9 +56,9 @@ __attribute__((weak)) uint8_t crc8(const void *data, size_t data_len) {
     return crc & 0xff;
 }
 #else
-__attribute__((weak)) uint8_t crc8(const void *data, size_t data_len) {
+uint8_t crc8_update(uint8_t seed, const void *data, size_t data_len) {
     const uint8_t *d   = (const uint8_t *)data;
-    crc_t          crc = 0xff;
+    crc_t          crc = seed;
     size_t         i, j;
 
     for (i = 0; i < data_len; i++) {
@@ -73,3 +73,7 @@ __attribute__((weak)) uint8_t crc8(const void *data, size_t data_len) {
     return crc;
 }
 #endif
+
+__attribute__((weak)) uint8_t crc8(const void *data, size_t data_len) {
+    return crc8_update(0xff, data, data_len);
+}
@@ -43,3 +43,14 @@ __attribute__((weak)) void crc_init(void);
  * \return             The calculated crc value.
  */
 __attribute__((weak)) uint8_t crc8(const void *data, size_t data_len);
+
+/**
+ * Continue a CRC8 calculation with more data, so that a CRC can be computed
+ * over data that arrives in pieces.
+ *
+ * \param[in] seed     The value returned for the previous piece, or 0xff to start.
+ * \param[in] data     Pointer to a buffer of \a data_len bytes.
+ * \param[in] data_len Number of bytes in the \a data buffer.
+ * \return             The calculated crc value.
+ */
+uint8_t crc8_update(uint8_t seed, const void *data, size_t data_len);
@@ -18,4 +18,14 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool
 
 void debounce_init(uint8_t num_rows);
 
+/**
+ * @brief Report a row of cooked that was modified by the current debounce() call.
+ *
+ * Debounce algorithms call this for every row they change so that matrix_task()
+ * only has to visit those rows.
+ *
+ * @param row Row index, relative to the cooked array passed to debounce()
+ */
+void debounce_row_changed(uint8_t row);
+
 void debounce_free(void);
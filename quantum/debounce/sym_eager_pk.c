@@ -141,7 +141,10 @@ static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], ui
             }
             debounce_pointer++;
         }
-        cooked[row] = existing_row;
+        if (existing_row != cooked[row]) {
+            cooked[row] = existing_row;
+            debounce_row_changed(row);
+        }
     }
 }
 
@@ -34,6 +34,12 @@ void     set_time(uint32_t t);
 void     advance_time(uint32_t ms);
 }
 
+static uint32_t changed_rows;
+
+extern "C" void debounce_row_changed(uint8_t row) {
+    changed_rows |= 1UL << row;
+}
+
 void DebounceTest::addEvents(std::initializer_list<DebounceTestEvent> events) {
     events_.insert(events_.end(), events.begin(), events.end());
 }
@@ -130,6 +136,7 @@ void DebounceTest::runDebounce(bool changed) {
     std::copy(std::begin(output_matrix_), std::end(output_matrix_), std::begin(cooked_matrix_));
 
     reset_access_counter();
+    changed_rows = 0;
 
     bool cooked_changed = debounce(raw_matrix_, cooked_matrix_, MATRIX_ROWS, changed);
 
@@ -141,6 +148,12 @@ void DebounceTest::runDebounce(bool changed) {
         FAIL() << "Fatal error: debounce() reported a wrong cooked matrix change result at " << strTime() << "\noutput_matrix: cooked_changed=" << cooked_changed << "\n" << strMatrix(output_matrix_) << "\ncooked_matrix:\n" << strMatrix(cooked_matrix_);
     }
 
+    for (int row = 0; row < MATRIX_ROWS; row++) {
+        if ((output_matrix_[row] != cooked_matrix_[row]) != !!(changed_rows & (1UL << row))) {
+            FAIL() << "Fatal error: debounce() reported a wrong changed row " << row << " at " << strTime() << "\noutput_matrix: changed_rows=" << changed_rows << "\n" << strMatrix(output_matrix_) << "\ncooked_matrix:\n" << strMatrix(cooked_matrix_);
+        }
+    }
+
     if (current_access_counter() > 1) {
         FAIL() << "Fatal error: debounce() read the timer multiple times, which is not allowed, at " << strTime() << "\ntimer: access_count=" << current_access_counter() << "\noutput_matrix: cooked_changed=" << cooked_changed << "\n" << strMatrix(output_matrix_) << "\ncooked_matrix:\n" << strMatrix(cooked_matrix_);
     }
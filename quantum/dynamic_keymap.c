@@ -21,6 +21,9 @@
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include "timer.h"
+#include "util.h"
+#include <string.h>
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -30,6 +33,10 @@
 #    define DYNAMIC_KEYMAP_EEPROM_START (EECONFIG_SIZE)
 #endif
 
+#ifdef KEYCODE_CACHE_ENABLE
+#    include "keycode_cache.h"
+#endif
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #else
@@ -101,6 +108,154 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// Milliseconds without writes before the mirror is written back to EEPROM
+#    ifndef DYNAMIC_KEYMAP_FLUSH_TIMEOUT
+#        define DYNAMIC_KEYMAP_FLUSH_TIMEOUT 1000
+#    endif
+// Milliseconds without writes before a transaction is dropped
+#    ifndef DYNAMIC_KEYMAP_TRANSACTION_TIMEOUT
+#        define DYNAMIC_KEYMAP_TRANSACTION_TIMEOUT 5000
+#    endif
+
+#    define DYNAMIC_KEYMAP_MIRROR_SIZE (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_EEPROM_ADDR + 1)
+
+_Static_assert(DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR >= DYNAMIC_KEYMAP_EEPROM_ADDR && DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR >= DYNAMIC_KEYMAP_EEPROM_ADDR && DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1 <= DYNAMIC_KEYMAP_EEPROM_MAX_ADDR, "DYNAMIC_KEYMAP_RAM_MIRROR requires the keymaps, encoders and macros to lie between DYNAMIC_KEYMAP_EEPROM_ADDR and DYNAMIC_KEYMAP_EEPROM_MAX_ADDR.");
+
+// RAM copy of the keymaps, encoders and macros, bytes dirty_first to
+// dirty_last (inclusive) having changed since the last write back.
+static uint8_t  mirror[DYNAMIC_KEYMAP_MIRROR_SIZE];
+static bool     mirror_loaded  = false;
+static bool     mirror_dirty   = false;
+static bool     in_transaction = false;
+static uint16_t dirty_first;
+static uint16_t dirty_last;
+static uint16_t last_write;
+static uint16_t last_transaction_write;
+
+static uint8_t *mirror_at(const void *addr) {
+    if (!mirror_loaded) {
+        eeprom_read_block(mirror, (const void *)DYNAMIC_KEYMAP_EEPROM_ADDR, DYNAMIC_KEYMAP_MIRROR_SIZE);
+        mirror_loaded = true;
+    }
+    return &mirror[(uintptr_t)addr - DYNAMIC_KEYMAP_EEPROM_ADDR];
+}
+
+// Changes made in a transaction stay out of sight until it is committed, and
+// EEPROM still holds everything else, as it was flushed when the transaction began.
+static void dynamic_keymap_read_block(void *buf, const void *addr, size_t len) {
+    if (in_transaction) {
+        eeprom_read_block(buf, addr, len);
+        return;
+    }
+    memcpy(buf, mirror_at(addr), len);
+}
+
+static void dynamic_keymap_update_block(const void *buf, void *addr, size_t len) {
+    const uint8_t *source = buf;
+    uint8_t       *target = mirror_at(addr);
+    const uint16_t offset = target - mirror;
+
+    if (in_transaction) {
+        last_transaction_write = timer_read();
+    }
+    for (uint16_t i = 0; i < len; i++) {
+        if (target[i] == source[i]) {
+            continue;
+        }
+        target[i] = source[i];
+        if (!mirror_dirty || offset + i < dirty_first) {
+            dirty_first = offset + i;
+        }
+        if (!mirror_dirty || offset + i > dirty_last) {
+            dirty_last = offset + i;
+        }
+        mirror_dirty = true;
+        last_write   = timer_read();
+    }
+}
+
+static uint8_t dynamic_keymap_read_byte(const void *addr) {
+    if (in_transaction) {
+        return eeprom_read_byte(addr);
+    }
+    return *mirror_at(addr);
+}
+
+static void dynamic_keymap_update_byte(void *addr, uint8_t value) {
+    dynamic_keymap_update_block(&value, addr, 1);
+}
+#else
+#    define dynamic_keymap_read_block eeprom_read_block
+#    define dynamic_keymap_update_block eeprom_update_block
+#    define dynamic_keymap_read_byte eeprom_read_byte
+#    define dynamic_keymap_update_byte eeprom_update_byte
+#endif
+
+void dynamic_keymap_flush(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (mirror_dirty && !in_transaction) {
+        eeprom_update_block(&mirror[dirty_first], ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + dirty_first, dirty_last - dirty_first + 1);
+        mirror_dirty = false;
+    }
+#endif
+}
+
+void dynamic_keymap_task(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (in_transaction && timer_elapsed(last_transaction_write) >= DYNAMIC_KEYMAP_TRANSACTION_TIMEOUT) {
+        dynamic_keymap_end_transaction(false);
+    }
+    if (mirror_dirty && timer_elapsed(last_write) >= DYNAMIC_KEYMAP_FLUSH_TIMEOUT) {
+        dynamic_keymap_flush();
+    }
+#endif
+}
+
+void dynamic_keymap_reload(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    mirror_loaded = false;
+    mirror_dirty  = false;
+#    ifdef KEYCODE_CACHE_ENABLE
+    keycode_cache_invalidate();
+#    endif
+#endif
+}
+
+void dynamic_keymap_begin_transaction(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    dynamic_keymap_flush();
+    in_transaction         = true;
+    last_transaction_write = timer_read();
+#endif
+}
+
+void dynamic_keymap_end_transaction(bool commit) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (!in_transaction) {
+        return;
+    }
+    in_transaction = false;
+    if (commit) {
+        dynamic_keymap_flush();
+#    ifdef KEYCODE_CACHE_ENABLE
+        // Lookups made during the transaction cached the keycodes it replaced
+        keycode_cache_invalidate();
+#    endif
+    } else {
+        dynamic_keymap_reload();
+    }
+#endif
+}
+
+bool dynamic_keymap_in_transaction(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    return in_transaction;
+#else
+    return false;
+#endif
+}
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -114,8 +269,8 @@ uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = eeprom_read_byte(address) << 8;
-    keycode |= eeprom_read_byte(address + 1);
+    uint16_t keycode = dynamic_keymap_read_byte(address) << 8;
+    keycode |= dynamic_keymap_read_byte(address + 1);
     return keycode;
 }
 
@@ -123,8 +278,11 @@ void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address, (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address, (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#ifdef KEYCODE_CACHE_ENABLE
+    keycode_cache_invalidate_key(row, column);
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -136,8 +294,8 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
-    keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
+    uint16_t keycode = ((uint16_t)dynamic_keymap_read_byte(address + (clockwise ? 0 : 2))) << 8;
+    keycode |= dynamic_keymap_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
 }
 
@@ -145,8 +303,8 @@ void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwis
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
-    eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
-    eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
+    dynamic_keymap_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -167,32 +325,28 @@ void dynamic_keymap_reset(void) {
     }
 }
 
+// Number of bytes of [offset, offset + size) that fall within a region of region_size bytes
+static uint16_t size_in_region(uint16_t offset, uint16_t size, uint16_t region_size) {
+    if (offset >= region_size) {
+        return 0;
+    }
+    return MIN(size, region_size - offset);
+}
+
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t available                  = size_in_region(offset, size, dynamic_keymap_eeprom_size);
+    dynamic_keymap_read_block(data, ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset, available);
+    memset(data + available, 0x00, size - available);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
-    }
+    uint16_t available                  = size_in_region(offset, size, dynamic_keymap_eeprom_size);
+    dynamic_keymap_update_block(data, ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset, available);
+#ifdef KEYCODE_CACHE_ENABLE
+    keycode_cache_invalidate();
+#endif
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,28 +374,20 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t available = size_in_region(offset, size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    dynamic_keymap_read_block(data, ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + offset, available);
+    memset(data + available, 0x00, size - available);
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    uint16_t available = size_in_region(offset, size, DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
+    dynamic_keymap_update_block(data, ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + offset, available);
+
+    // The last byte of the buffer marks it valid, see dynamic_keymap.h: write
+    // back right away when it changes, so that it reaches EEPROM before the
+    // macros it protects when it's set, and after them when it's cleared.
+    if (offset + available == DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE && available > 0) {
+        dynamic_keymap_flush();
     }
 }
 
@@ -249,7 +395,7 @@ void dynamic_keymap_macro_reset(void) {
     void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
     void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
     while (p != end) {
-        eeprom_update_byte(p, 0);
+        dynamic_keymap_update_byte(p, 0);
         ++p;
     }
 }
@@ -264,7 +410,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
     // of buffer writing, possibly an aborted buffer
     // write. So do nothing.
     void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
+    if (dynamic_keymap_read_byte(p) != 0) {
         return;
     }
 
@@ -278,7 +424,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
         if (p == end) {
             return;
         }
-        if (eeprom_read_byte(p) == 0) {
+        if (dynamic_keymap_read_byte(p) == 0) {
             --id;
         }
         ++p;
@@ -289,7 +435,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
     // We already checked there was a null at the end of
     // the buffer, so this cannot go past the end
     while (1) {
-        data[0] = eeprom_read_byte(p++);
+        data[0] = dynamic_keymap_read_byte(p++);
         data[1] = 0;
         // Stop at the null terminator of this macro string
         if (data[0] == 0) {
@@ -297,14 +443,14 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         if (data[0] == SS_QMK_PREFIX) {
             // Get the code
-            data[1] = eeprom_read_byte(p++);
+            data[1] = dynamic_keymap_read_byte(p++);
             // Unexpected null, abort.
             if (data[1] == 0) {
                 return;
             }
             if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
                 // Get the keycode
-                data[2] = eeprom_read_byte(p++);
+                data[2] = dynamic_keymap_read_byte(p++);
                 // Unexpected null, abort.
                 if (data[2] == 0) {
                     return;
@@ -316,7 +462,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
                 // At most this is 4 digits plus '|'
                 uint8_t i = 2;
                 while (1) {
-                    data[i] = eeprom_read_byte(p++);
+                    data[i] = dynamic_keymap_read_byte(p++);
                     // Unexpected null, abort
                     if (data[i] == 0) {
                         return;
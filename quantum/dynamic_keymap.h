@@ -27,6 +27,26 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
 void     dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode);
 #endif // ENCODER_MAP_ENABLE
 void dynamic_keymap_reset(void);
+
+// With DYNAMIC_KEYMAP_RAM_MIRROR, the keymaps, encoders and macros are read
+// from EEPROM once and served from RAM, and changes are written back in one
+// block DYNAMIC_KEYMAP_FLUSH_TIMEOUT milliseconds after the last of them.
+// These do nothing otherwise.
+void dynamic_keymap_task(void);
+// Writes pending changes back to EEPROM right away
+void dynamic_keymap_flush(void);
+// Drops the RAM copy, after the EEPROM was modified behind its back
+void dynamic_keymap_reload(void);
+// Holds back writing changes to EEPROM until the transaction ends, and then
+// either writes them all, or drops them. Until then, reads return what was
+// there before the transaction began. A transaction without changes for
+// DYNAMIC_KEYMAP_TRANSACTION_TIMEOUT milliseconds is dropped by
+// dynamic_keymap_task(). Without DYNAMIC_KEYMAP_RAM_MIRROR, changes are
+// written right away and there is never a transaction in progress.
+void dynamic_keymap_begin_transaction(void);
+void dynamic_keymap_end_transaction(bool commit);
+bool dynamic_keymap_in_transaction(void);
+
 // These get/set the keycodes as stored in the EEPROM buffer
 // Data is big-endian 16-bit values (the keycodes)
 // Order is by layer/row/column
@@ -19,6 +19,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "keyboard.h"
 #include "keycode_config.h"
 #include "matrix.h"
+#include "debounce.h"
 #include "keymap_introspection.h"
 #include "magic.h"
 #include "host.h"
@@ -33,6 +34,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "latency_trace.h"
 #ifdef AUDIO_ENABLE
 #    include "audio.h"
 #endif
@@ -99,6 +101,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef ST7565_ENABLE
 #    include "st7565.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
@@ -120,6 +125,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef SPLIT_KEYBOARD
 #    include "split_util.h"
 #endif
+#ifdef SPLIT_LINK_STATS_ENABLE
+#    include "link_stats.h"
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION)
+#    include "wear_leveling.h"
+#endif
 #ifdef BLUETOOTH_ENABLE
 #    include "bluetooth.h"
 #endif
@@ -459,6 +470,9 @@ void keyboard_init(void) {
 #ifdef HAPTIC_ENABLE
     haptic_init();
 #endif
+#ifdef COMBO_ENABLE
+    combo_init();
+#endif
 
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
@@ -489,15 +503,72 @@ static inline void generate_tick_event(void) {
     static uint16_t last_tick = 0;
     const uint16_t  now       = timer_read();
     if (TIMER_DIFF_16(now, last_tick) != 0) {
-        action_exec(MAKE_TICK_EVENT);
+        LATENCY_TRACE(LATENCY_TRACE_ACTION_EXEC, action_exec(MAKE_TICK_EVENT));
         last_tick = now;
     }
 }
 
+// __builtin_ctz() only takes an int, which is 16 bits wide on AVR
+#if (MATRIX_ROWS <= 16)
+#    define matrix_dirty_ctz(bits) __builtin_ctz(bits)
+#else
+#    define matrix_dirty_ctz(bits) __builtin_ctzl(bits)
+#endif
+#if (MATRIX_COLS <= 16)
+#    define matrix_row_ctz(bits) __builtin_ctz(bits)
+#else
+#    define matrix_row_ctz(bits) __builtin_ctzl(bits)
+#endif
+
+static matrix_dirty_t matrix_dirty_rows[MATRIX_DIRTY_WORDS];
+static bool           matrix_dirty_rows_tracked  = false;
+static bool           matrix_dirty_rows_reported = false;
+static uint8_t        matrix_dirty_rows_offset   = 0;
+
+/** \brief Marks a row of the debounced matrix as changed since the last matrix_task
+ */
+void matrix_set_row_dirty(uint8_t row) {
+    matrix_dirty_rows[row / MATRIX_DIRTY_BITS] |= (matrix_dirty_t)1 << (row % MATRIX_DIRTY_BITS);
+}
+
+/** \brief Starts dirty row tracking for the current matrix scan
+ *
+ * Called by matrix_scan() implementations that report every row they modify. Scans that
+ * never call this make matrix_task() fall back to checking every row.
+ *
+ * \param offset row of the matrix that debounce_row_changed() row 0 refers to
+ */
+void matrix_dirty_rows_begin(uint8_t offset) {
+    matrix_dirty_rows_tracked  = true;
+    matrix_dirty_rows_reported = false;
+    matrix_dirty_rows_offset   = offset;
+}
+
+/** \brief Finishes dirty row tracking for the debounced rows of the current scan
+ *
+ * Debounce algorithms that do not report rows through debounce_row_changed() still
+ * flag changes through their return value, in which case all of their rows are dirty.
+ */
+void matrix_dirty_rows_end(uint8_t num_rows, bool changed) {
+    if (changed && !matrix_dirty_rows_reported) {
+        for (uint8_t row = 0; row < num_rows; row++) {
+            matrix_set_row_dirty(matrix_dirty_rows_offset + row);
+        }
+    }
+}
+
+void debounce_row_changed(uint8_t row) {
+    matrix_dirty_rows_reported = true;
+    matrix_set_row_dirty(matrix_dirty_rows_offset + row);
+}
+
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
  *
+ * Only the rows published as dirty by matrix_scan() are visited, so a scan
+ * without changes costs a handful of word compares regardless of matrix size.
+ *
  * @return true Matrix did change
  * @return false Matrix didn't change
  */
@@ -509,48 +580,82 @@ static bool matrix_task(void) {
 
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
-    matrix_scan();
-    bool matrix_changed = false;
-    for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
-        matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
-    }
-
+#ifdef LATENCY_TRACE_ENABLE
+    const uint32_t scan_start = latency_trace_timestamp();
+#endif
+    LATENCY_TRACE(LATENCY_TRACE_MATRIX_SCAN, matrix_scan());
     matrix_scan_perf_task();
 
-    // Short-circuit the complete matrix processing if it is not necessary
-    if (!matrix_changed) {
-        generate_tick_event();
-        return matrix_changed;
+    // Custom matrix_scan implementations don't publish dirty rows, check all of them
+    if (!matrix_dirty_rows_tracked) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            matrix_set_row_dirty(row);
+        }
     }
+    matrix_dirty_rows_tracked = false;
 
-    if (debug_config.matrix) {
-        matrix_print();
-    }
+    bool matrix_changed   = false;
+    bool process_keypress = false;
 
-    const bool process_keypress = should_process_keypress();
+    for (uint8_t word = 0; word < MATRIX_DIRTY_WORDS; word++) {
+        matrix_dirty_t dirty    = matrix_dirty_rows[word];
+        matrix_dirty_rows[word] = 0;
 
-    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
-        const matrix_row_t current_row = matrix_get_row(row);
-        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+        while (dirty) {
+            const uint8_t row = word * MATRIX_DIRTY_BITS + matrix_dirty_ctz(dirty);
+            dirty &= dirty - 1;
 
-        if (!row_changes || has_ghost_in_row(row, current_row)) {
-            continue;
-        }
+            const matrix_row_t current_row = matrix_get_row(row);
+            const matrix_row_t row_changes = current_row ^ matrix_previous[row];
 
-        matrix_row_t col_mask = 1;
-        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
-            if (row_changes & col_mask) {
-                const bool key_pressed = current_row & col_mask;
+            if (!row_changes) {
+                continue;
+            }
+
+            if (!matrix_changed) {
+                matrix_changed = true;
+#ifdef LATENCY_TRACE_ENABLE
+                latency_trace_scan_changed(scan_start);
+#endif
+
+                if (debug_config.matrix) {
+                    matrix_print();
+                }
+
+                process_keypress = should_process_keypress();
+            }
+
+            if (has_ghost_in_row(row, current_row)) {
+                // keep the row pending until the ghost clears
+                matrix_set_row_dirty(row);
+                continue;
+            }
+
+            matrix_row_t col_changes = row_changes;
+            while (col_changes) {
+                const uint8_t col = matrix_row_ctz(col_changes);
+                col_changes &= col_changes - 1;
+
+                const bool key_pressed = current_row & (MATRIX_ROW_SHIFTER << col);
+
+#ifdef LATENCY_TRACE_ENABLE
+                latency_trace_key_changed(row, col);
+#endif
 
                 if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
+                    LATENCY_TRACE(LATENCY_TRACE_ACTION_EXEC, action_exec(MAKE_KEYEVENT(row, col, key_pressed)));
                 }
 
                 switch_events(row, col, key_pressed);
             }
+
+            matrix_previous[row] = current_row;
         }
+    }
 
-        matrix_previous[row] = current_row;
+    // Short-circuit the complete matrix processing if it is not necessary
+    if (!matrix_changed) {
+        generate_tick_event();
     }
 
     return matrix_changed;
@@ -629,6 +734,18 @@ void quantum_task(void) {
 #ifdef SECURE_ENABLE
     secure_task();
 #endif
+
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_task();
+#endif
+
+#if defined(EEPROM_DRIVER) && defined(EEPROM_WRITE_BACK)
+    eeprom_driver_task();
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_task();
+#endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
@@ -645,6 +762,14 @@ void keyboard_task(void) {
     split_watchdog_task();
 #endif
 
+#ifdef SPLIT_LINK_STATS_ENABLE
+    split_link_stats_task();
+#endif
+
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION)
+    wear_leveling_task();
+#endif
+
 #if defined(RGBLIGHT_ENABLE)
     rgblight_task();
 #endif
@@ -653,7 +778,10 @@ void keyboard_task(void) {
     led_matrix_task();
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    LATENCY_TRACE(LATENCY_TRACE_RGB_MATRIX_TASK, rgb_matrix_task());
+#endif
+#if defined(ISSI_INCREMENTAL_FLUSH) && (defined(LED_MATRIX_ENABLE) || defined(RGB_MATRIX_ENABLE))
+    issi_incremental_flush_task();
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
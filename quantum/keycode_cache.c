@@ -0,0 +1,107 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode_cache.h"
+#include <string.h>
+#include "action.h"
+#include "action_layer.h"
+#include "keymap_common.h"
+#include "matrix.h"
+
+#ifdef NO_ACTION_LAYER
+#    error "KEYCODE_CACHE_ENABLE requires layers"
+#endif
+
+static matrix_row_t  cache_valid[MATRIX_ROWS];
+static uint8_t       cache_layer[MATRIX_ROWS][MATRIX_COLS];
+static uint16_t      cache_keycode[MATRIX_ROWS][MATRIX_COLS];
+static layer_state_t cache_layers;
+
+static inline bool is_cached(uint8_t row, uint8_t col) {
+    return cache_valid[row] & ((matrix_row_t)1 << col);
+}
+
+static void resolve(keypos_t key) {
+    const layer_state_t layers  = cache_layers;
+    uint8_t             layer   = 0;
+    uint16_t            keycode = KC_TRANSPARENT;
+
+    /* check top layer first */
+    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+        if (layers & ((layer_state_t)1 << i)) {
+            keycode = keymap_key_to_keycode(i, key);
+            if (action_for_keycode(keycode).code != ACTION_TRANSPARENT) {
+                layer = i;
+                break;
+            }
+        }
+    }
+    /* fall back to layer 0 */
+    if (layer == 0 && !(layers & 1)) {
+        keycode = keymap_key_to_keycode(0, key);
+    }
+
+    cache_layer[key.row][key.col]   = layer;
+    cache_keycode[key.row][key.col] = keycode;
+    cache_valid[key.row] |= (matrix_row_t)1 << key.col;
+}
+
+static inline void check_layer_state(void) {
+    if ((layer_state | default_layer_state) != cache_layers) {
+        // layer_state was written to directly
+        keycode_cache_layer_state_changed();
+    }
+}
+
+uint8_t keycode_cache_get_layer(keypos_t key) {
+    check_layer_state();
+    if (!is_cached(key.row, key.col)) {
+        resolve(key);
+    }
+    return cache_layer[key.row][key.col];
+}
+
+uint16_t keycode_cache_get_keycode(uint8_t layer, keypos_t key) {
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        check_layer_state();
+        if (is_cached(key.row, key.col) && cache_layer[key.row][key.col] == layer) {
+            return cache_keycode[key.row][key.col];
+        }
+    }
+    return keymap_key_to_keycode(layer, key);
+}
+
+void keycode_cache_layer_state_changed(void) {
+    const layer_state_t layers    = layer_state | default_layer_state;
+    const layer_state_t changed   = layers ^ cache_layers;
+    const layer_state_t turned_on = changed & layers;
+    cache_layers                  = layers;
+
+    if (!changed) {
+        return;
+    }
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (!is_cached(row, col)) {
+                continue;
+            }
+            /* Layers above the resolved one were transparent, and those below it are hidden:
+             * only turning the resolved layer off, or a layer above it on, can change the result. */
+            const uint8_t layer = cache_layer[row][col];
+            if (((changed >> layer) & 1) || ((turned_on >> layer) >> 1)) {
+                cache_valid[row] &= ~((matrix_row_t)1 << col);
+            }
+        }
+    }
+}
+
+void keycode_cache_invalidate_key(uint8_t row, uint8_t col) {
+    if (row < MATRIX_ROWS && col < MATRIX_COLS) {
+        cache_valid[row] &= ~((matrix_row_t)1 << col);
+    }
+}
+
+void keycode_cache_invalidate(void) {
+    memset(cache_valid, 0, sizeof(cache_valid));
+}
@@ -0,0 +1,49 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Layer-resolved keycode cache, enabled with KEYCODE_CACHE_ENABLE = yes.
+
+    Remembers, for every matrix position, the highest active layer that isn't
+    transparent there and the keycode found on it, so that resolving a key
+    doesn't walk the layer stack, nor read the dynamic keymap from EEPROM, more
+    than once per layer state.
+
+    Entries are invalidated incrementally when the layer state changes: only the
+    keys whose resolved layer was turned off, or which sit below a layer that
+    was turned on, are resolved again. Code modifying the keymap at runtime has
+    to call keycode_cache_invalidate_key() or keycode_cache_invalidate().
+*/
+
+#include <stdint.h>
+#include "keyboard.h"
+
+/**
+ * @brief Gets the highest active, non-transparent layer at `key`, which must be
+ * a matrix position.
+ */
+uint8_t keycode_cache_get_layer(keypos_t key);
+
+/**
+ * @brief Gets the keycode at `key` on `layer`, from the cache when `layer` is
+ * the one `key` was last resolved to by keycode_cache_get_layer().
+ */
+uint16_t keycode_cache_get_keycode(uint8_t layer, keypos_t key);
+
+/**
+ * @brief Drops the entries affected by a change of `layer_state` or
+ * `default_layer_state`.
+ */
+void keycode_cache_layer_state_changed(void);
+
+/**
+ * @brief Drops the entry of one matrix position, after its keycode changed on
+ * any layer.
+ */
+void keycode_cache_invalidate_key(uint8_t row, uint8_t col);
+
+/**
+ * @brief Drops every entry.
+ */
+void keycode_cache_invalidate(void);
@@ -29,6 +29,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "encoder.h"
 #endif
 
+#ifdef KEYCODE_CACHE_ENABLE
+#    include "keycode_cache.h"
+#endif
+
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
@@ -44,7 +48,11 @@ extern keymap_config_t keymap_config;
 /* converts key to action */
 action_t action_for_key(uint8_t layer, keypos_t key) {
     // 16bit keycodes - important
+#ifdef KEYCODE_CACHE_ENABLE
+    uint16_t keycode = keycode_cache_get_keycode(layer, key);
+#else
     uint16_t keycode = keymap_key_to_keycode(layer, key);
+#endif
     return action_for_keycode(keycode);
 };
 
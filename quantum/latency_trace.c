@@ -0,0 +1,432 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "latency_trace.h"
+
+#include <string.h>
+#include "timer.h"
+#include "print.h"
+#include "util.h"
+
+typedef struct {
+    uint8_t  stage;
+    uint32_t ticks;
+} latency_trace_sample_t;
+
+// Single producer, single consumer: `ring_head` is only written by latency_trace_record(),
+// `ring_tail` only by latency_trace_task(), and both fit in a single byte so reads are atomic.
+static latency_trace_sample_t ring[LATENCY_TRACE_RING_SIZE];
+static volatile uint8_t       ring_head = 0;
+static volatile uint8_t       ring_tail = 0;
+static volatile uint16_t      dropped   = 0;
+
+// Last key change that hasn't been matched with a report yet
+static bool     change_pending = false;
+static uint32_t change_ticks;
+static uint16_t change_time;
+static uint16_t unmatched = 0;
+
+// Keys whose raw state changed, which the debounced matrix hasn't caught up with yet
+typedef struct {
+    uint8_t  row;
+    uint8_t  col;
+    uint16_t time;
+    uint32_t ticks;
+} latency_trace_raw_change_t;
+
+static latency_trace_raw_change_t raw_changes[LATENCY_TRACE_RAW_CHANGES];
+static uint8_t                    raw_change_count = 0;
+
+static uint16_t histogram[LATENCY_TRACE_STAGE_COUNT][LATENCY_TRACE_BUCKETS];
+static uint32_t sample_count[LATENCY_TRACE_STAGE_COUNT];
+static uint32_t sample_max[LATENCY_TRACE_STAGE_COUNT];
+
+uint32_t latency_trace_timestamp(void) {
+    return timer_read_ticks();
+}
+
+uint32_t latency_trace_tick_frequency(void) {
+    return timer_ticks_frequency();
+}
+
+void latency_trace_record(latency_trace_stage_t stage, uint32_t ticks) {
+    const uint8_t head = ring_head;
+    const uint8_t next = (head + 1) & (LATENCY_TRACE_RING_SIZE - 1);
+
+    if (next == ring_tail) {
+        if (dropped < UINT16_MAX) {
+            dropped++;
+        }
+        return;
+    }
+
+    ring[head].stage = stage;
+    ring[head].ticks = ticks;
+    // Publish the sample only once it has been written
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    ring_head = next;
+}
+
+void latency_trace_scan_changed(uint32_t scan_start) {
+    if (change_pending && unmatched < UINT16_MAX) {
+        unmatched++;
+    }
+
+    change_pending = true;
+    change_ticks   = scan_start;
+    change_time    = timer_read();
+}
+
+static uint8_t latency_trace_find_raw_change(uint8_t row, uint8_t col) {
+    uint8_t i = 0;
+    while (i < raw_change_count && (raw_changes[i].row != row || raw_changes[i].col != col)) {
+        i++;
+    }
+    return i;
+}
+
+void latency_trace_raw_changed(uint8_t row, uint32_t changes) {
+    const uint32_t now  = latency_trace_timestamp();
+    const uint16_t time = timer_read();
+
+    while (changes) {
+        const uint8_t col = __builtin_ctzl(changes);
+        changes &= changes - 1;
+
+        uint8_t i = latency_trace_find_raw_change(row, col);
+        if (i < raw_change_count) {
+            // Still bouncing or being debounced, unless debouncing filtered that change out long ago
+            if (TIMER_DIFF_16(time, raw_changes[i].time) <= LATENCY_TRACE_REPORT_TIMEOUT) {
+                continue;
+            }
+        } else if (raw_change_count < LATENCY_TRACE_RAW_CHANGES) {
+            i = raw_change_count++;
+        } else {
+            // Replace the oldest change
+            i = 0;
+            for (uint8_t j = 1; j < raw_change_count; j++) {
+                if (TIMER_DIFF_16(time, raw_changes[j].time) > TIMER_DIFF_16(time, raw_changes[i].time)) {
+                    i = j;
+                }
+            }
+        }
+
+        raw_changes[i].row   = row;
+        raw_changes[i].col   = col;
+        raw_changes[i].time  = time;
+        raw_changes[i].ticks = now;
+    }
+}
+
+void latency_trace_key_changed(uint8_t row, uint8_t col) {
+    const uint8_t i = latency_trace_find_raw_change(row, col);
+    if (i == raw_change_count) {
+        return;
+    }
+
+    // Changes picked up in the same scan are stamped after its start
+    if (change_pending && (uint32_t)(change_ticks - raw_changes[i].ticks) < UINT32_MAX / 2) {
+        change_ticks = raw_changes[i].ticks;
+    }
+    raw_changes[i] = raw_changes[--raw_change_count];
+}
+
+void latency_trace_report_sent(void) {
+    if (!change_pending) {
+        return;
+    }
+    change_pending = false;
+
+    // Most likely sent on a timer, e.g. a tap-hold key resolving as held
+    if (timer_elapsed(change_time) > LATENCY_TRACE_REPORT_TIMEOUT) {
+        if (unmatched < UINT16_MAX) {
+            unmatched++;
+        }
+        return;
+    }
+
+    latency_trace_record(LATENCY_TRACE_SCAN_TO_REPORT, latency_trace_timestamp() - change_ticks);
+}
+
+uint16_t latency_trace_unmatched(void) {
+    return unmatched;
+}
+
+const char *latency_trace_debounce_type(void) {
+#ifdef LATENCY_TRACE_DEBOUNCE_TYPE
+    return LATENCY_TRACE_DEBOUNCE_TYPE;
+#else
+    return "unknown";
+#endif
+}
+
+uint16_t latency_trace_features(void) {
+    return 0
+#ifdef AUTO_SHIFT_ENABLE
+           | LATENCY_TRACE_FEATURE_AUTO_SHIFT
+#endif
+#ifdef AUTOCORRECT_ENABLE
+           | LATENCY_TRACE_FEATURE_AUTOCORRECT
+#endif
+#ifdef CAPS_WORD_ENABLE
+           | LATENCY_TRACE_FEATURE_CAPS_WORD
+#endif
+#ifdef COMBO_ENABLE
+           | LATENCY_TRACE_FEATURE_COMBO
+#endif
+#ifdef KEY_OVERRIDE_ENABLE
+           | LATENCY_TRACE_FEATURE_KEY_OVERRIDE
+#endif
+#ifdef LEADER_ENABLE
+           | LATENCY_TRACE_FEATURE_LEADER
+#endif
+#ifdef TAP_DANCE_ENABLE
+           | LATENCY_TRACE_FEATURE_TAP_DANCE
+#endif
+#ifdef NKRO_ENABLE
+           | LATENCY_TRACE_FEATURE_NKRO
+#endif
+#ifdef RGB_MATRIX_ENABLE
+           | LATENCY_TRACE_FEATURE_RGB_MATRIX
+#endif
+#ifdef LED_MATRIX_ENABLE
+           | LATENCY_TRACE_FEATURE_LED_MATRIX
+#endif
+#ifdef RGBLIGHT_ENABLE
+           | LATENCY_TRACE_FEATURE_RGBLIGHT
+#endif
+#ifdef SPLIT_KEYBOARD
+           | LATENCY_TRACE_FEATURE_SPLIT
+#endif
+        ;
+}
+
+static uint8_t latency_trace_bucket(uint32_t ticks) {
+    if (ticks < LATENCY_TRACE_SUB_BUCKETS) {
+        return ticks;
+    }
+
+    // Position of the most significant bit, regardless of the width of long
+    const uint8_t msb = (sizeof(unsigned long) * 8 - 1) - __builtin_clzl(ticks);
+    if (msb >= LATENCY_TRACE_MAX_BITS) {
+        return LATENCY_TRACE_BUCKETS - 1;
+    }
+
+    const uint8_t sub = (ticks >> (msb - LATENCY_TRACE_SUB_BUCKET_BITS)) & (LATENCY_TRACE_SUB_BUCKETS - 1);
+    return (msb - LATENCY_TRACE_SUB_BUCKET_BITS + 1) * LATENCY_TRACE_SUB_BUCKETS + sub;
+}
+
+static uint32_t latency_trace_bucket_upper_bound(uint8_t bucket) {
+    if (bucket < LATENCY_TRACE_SUB_BUCKETS) {
+        return bucket;
+    }
+    if (bucket == LATENCY_TRACE_BUCKETS - 1) {
+        return UINT32_MAX;
+    }
+
+    const uint8_t  shift = bucket / LATENCY_TRACE_SUB_BUCKETS - 1;
+    const uint32_t lower = (uint32_t)(LATENCY_TRACE_SUB_BUCKETS + bucket % LATENCY_TRACE_SUB_BUCKETS) << shift;
+    return lower + (((uint32_t)1 << shift) - 1);
+}
+
+static void latency_trace_add(uint8_t stage, uint32_t ticks) {
+    if (stage >= LATENCY_TRACE_STAGE_COUNT) {
+        return;
+    }
+
+    uint16_t *buckets = histogram[stage];
+    uint8_t   bucket  = latency_trace_bucket(ticks);
+
+    if (buckets[bucket] == UINT16_MAX) {
+        // Halve the whole histogram so the distribution is kept while making room
+        for (uint8_t i = 0; i < LATENCY_TRACE_BUCKETS; i++) {
+            buckets[i] = (buckets[i] + 1) / 2;
+        }
+    }
+    buckets[bucket]++;
+
+    if (sample_count[stage] < UINT32_MAX) {
+        sample_count[stage]++;
+    }
+    if (ticks > sample_max[stage]) {
+        sample_max[stage] = ticks;
+    }
+}
+
+void latency_trace_task(void) {
+    uint8_t tail = ring_tail;
+
+    while (tail != ring_head) {
+        // Read the sample before handing its slot back to the producer
+        __atomic_signal_fence(__ATOMIC_SEQ_CST);
+        latency_trace_add(ring[tail].stage, ring[tail].ticks);
+        tail      = (tail + 1) & (LATENCY_TRACE_RING_SIZE - 1);
+        ring_tail = tail;
+    }
+
+#ifdef LATENCY_TRACE_PRINT_INTERVAL
+    static uint32_t last_print = 0;
+    if (timer_elapsed32(last_print) > LATENCY_TRACE_PRINT_INTERVAL) {
+        latency_trace_print();
+        last_print = timer_read32();
+    }
+#endif
+}
+
+static uint32_t latency_trace_percentile(const uint16_t *buckets, uint32_t total, uint8_t percent) {
+    // Smallest bucket that holds at least `percent` of the samples
+    const uint32_t target = ((uint64_t)total * percent + 99) / 100;
+    uint32_t       seen   = 0;
+
+    for (uint8_t i = 0; i < LATENCY_TRACE_BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= target) {
+            return latency_trace_bucket_upper_bound(i);
+        }
+    }
+
+    return UINT32_MAX;
+}
+
+void latency_trace_get_stats(latency_trace_stage_t stage, latency_trace_stats_t *stats) {
+    memset(stats, 0, sizeof(latency_trace_stats_t));
+    if (stage >= LATENCY_TRACE_STAGE_COUNT || !sample_count[stage]) {
+        return;
+    }
+
+    const uint16_t *buckets = histogram[stage];
+    uint32_t        total   = 0;
+    for (uint8_t i = 0; i < LATENCY_TRACE_BUCKETS; i++) {
+        total += buckets[i];
+    }
+
+    stats->count = sample_count[stage];
+    stats->max   = sample_max[stage];
+    stats->p50   = MIN(latency_trace_percentile(buckets, total, 50), stats->max);
+    stats->p99   = MIN(latency_trace_percentile(buckets, total, 99), stats->max);
+}
+
+uint16_t latency_trace_dropped(void) {
+    return dropped;
+}
+
+void latency_trace_reset(void) {
+    // Discard anything still queued, as it was measured before the reset
+    ring_tail        = ring_head;
+    dropped          = 0;
+    unmatched        = 0;
+    change_pending   = false;
+    raw_change_count = 0;
+
+    memset(histogram, 0, sizeof(histogram));
+    memset(sample_count, 0, sizeof(sample_count));
+    memset(sample_max, 0, sizeof(sample_max));
+}
+
+const char *latency_trace_stage_name(latency_trace_stage_t stage) {
+    switch (stage) {
+        case LATENCY_TRACE_MATRIX_SCAN:
+            return "matrix_scan";
+        case LATENCY_TRACE_DEBOUNCE:
+            return "debounce";
+        case LATENCY_TRACE_ACTION_EXEC:
+            return "action_exec";
+        case LATENCY_TRACE_PROCESS_RECORD_QUANTUM:
+            return "process_record_quantum";
+        case LATENCY_TRACE_RGB_MATRIX_TASK:
+            return "rgb_matrix_task";
+        case LATENCY_TRACE_HOST_KEYBOARD_SEND:
+            return "host_keyboard_send";
+        case LATENCY_TRACE_SCAN_TO_REPORT:
+            return "scan_to_report";
+        default:
+            return "unknown";
+    }
+}
+
+void latency_trace_print(void) {
+    uprintf("latency trace (%lu ticks/s, %u dropped, %u unmatched)\n", (unsigned long)latency_trace_tick_frequency(), (unsigned)dropped, (unsigned)unmatched);
+    uprintf("debounce: %s, features: %04X\n", latency_trace_debounce_type(), latency_trace_features());
+
+    for (uint8_t stage = 0; stage < LATENCY_TRACE_STAGE_COUNT; stage++) {
+        latency_trace_stats_t stats;
+        latency_trace_get_stats(stage, &stats);
+        if (!stats.count) {
+            continue;
+        }
+
+        uprintf("%s: n=%lu p50=%lu p99=%lu max=%lu\n", latency_trace_stage_name(stage), (unsigned long)stats.count, (unsigned long)stats.p50, (unsigned long)stats.p99, (unsigned long)stats.max);
+    }
+}
+
+static void latency_trace_write_u32(uint8_t *data, uint32_t value) {
+    data[0] = (value >> 24) & 0xFF;
+    data[1] = (value >> 16) & 0xFF;
+    data[2] = (value >> 8) & 0xFF;
+    data[3] = value & 0xFF;
+}
+
+enum latency_trace_command {
+    latency_trace_get_info  = 0x01,
+    latency_trace_get_stage = 0x02,
+    latency_trace_clear     = 0x03,
+    latency_trace_get_build = 0x04,
+    latency_trace_error     = 0xFF,
+};
+
+bool latency_trace_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ LATENCY_TRACE_RAW_HID_ID, command, payload... ], replies use big endian values
+    if (length < 19 || data[0] != LATENCY_TRACE_RAW_HID_ID) {
+        return false;
+    }
+
+    // Bring the histograms up to date before reporting them
+    latency_trace_task();
+
+    switch (data[1]) {
+        case latency_trace_get_info: {
+            // [ id, command, stage count, dropped (2), tick frequency (4) ]
+            data[2] = LATENCY_TRACE_STAGE_COUNT;
+            data[3] = dropped >> 8;
+            data[4] = dropped & 0xFF;
+            latency_trace_write_u32(&data[5], latency_trace_tick_frequency());
+            break;
+        }
+        case latency_trace_get_stage: {
+            // [ id, command, stage, count (4), p50 (4), p99 (4), max (4) ]
+            if (data[2] >= LATENCY_TRACE_STAGE_COUNT) {
+                data[1] = latency_trace_error;
+                break;
+            }
+
+            latency_trace_stats_t stats;
+            latency_trace_get_stats(data[2], &stats);
+            latency_trace_write_u32(&data[3], stats.count);
+            latency_trace_write_u32(&data[7], stats.p50);
+            latency_trace_write_u32(&data[11], stats.p99);
+            latency_trace_write_u32(&data[15], stats.max);
+            break;
+        }
+        case latency_trace_clear: {
+            latency_trace_reset();
+            break;
+        }
+        case latency_trace_get_build: {
+            // [ id, command, unmatched (2), features (2), debounce type (NUL terminated) ]
+            const uint16_t features = latency_trace_features();
+            data[2]                 = unmatched >> 8;
+            data[3]                 = unmatched & 0xFF;
+            data[4]                 = features >> 8;
+            data[5]                 = features & 0xFF;
+            strncpy((char *)&data[6], latency_trace_debounce_type(), length - 7);
+            data[length - 1] = 0;
+            break;
+        }
+        default: {
+            data[1] = latency_trace_error;
+            break;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,228 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Per-stage latency histograms, enabled with LATENCY_TRACE_ENABLE = yes.
+
+    Each traced call is timed with the platform's high resolution counter and
+    pushed into a fixed-size lock-free ring, which latency_trace_task() drains
+    into one log-linear histogram per stage. The p50, p99 and max of every stage
+    can then be read over console or raw HID.
+
+    On top of that, the end-to-end latency from the scan that saw a key change
+    to the keyboard report leaving through the USB driver is tracked as its own
+    stage, labelled with the debounce algorithm and processing features built in.
+
+    Usage example:
+
+        #include "latency_trace.h"
+
+        LATENCY_TRACE(LATENCY_TRACE_MATRIX_SCAN, matrix_scan());
+
+    When the feature is disabled the macro expands to the plain call.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef enum {
+    LATENCY_TRACE_MATRIX_SCAN,
+    LATENCY_TRACE_DEBOUNCE,
+    LATENCY_TRACE_ACTION_EXEC,
+    LATENCY_TRACE_PROCESS_RECORD_QUANTUM,
+    LATENCY_TRACE_RGB_MATRIX_TASK,
+    LATENCY_TRACE_HOST_KEYBOARD_SEND,
+    LATENCY_TRACE_SCAN_TO_REPORT,
+    LATENCY_TRACE_STAGE_COUNT,
+} latency_trace_stage_t;
+
+typedef enum {
+    LATENCY_TRACE_FEATURE_AUTO_SHIFT   = (1 << 0),
+    LATENCY_TRACE_FEATURE_AUTOCORRECT  = (1 << 1),
+    LATENCY_TRACE_FEATURE_CAPS_WORD    = (1 << 2),
+    LATENCY_TRACE_FEATURE_COMBO        = (1 << 3),
+    LATENCY_TRACE_FEATURE_KEY_OVERRIDE = (1 << 4),
+    LATENCY_TRACE_FEATURE_LEADER       = (1 << 5),
+    LATENCY_TRACE_FEATURE_TAP_DANCE    = (1 << 6),
+    LATENCY_TRACE_FEATURE_NKRO         = (1 << 7),
+    LATENCY_TRACE_FEATURE_RGB_MATRIX   = (1 << 8),
+    LATENCY_TRACE_FEATURE_LED_MATRIX   = (1 << 9),
+    LATENCY_TRACE_FEATURE_RGBLIGHT     = (1 << 10),
+    LATENCY_TRACE_FEATURE_SPLIT        = (1 << 11),
+} latency_trace_feature_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t max;
+} latency_trace_stats_t;
+
+#ifdef LATENCY_TRACE_ENABLE
+
+// Must be a power of two, and no larger than 256
+#    ifndef LATENCY_TRACE_RING_SIZE
+#        define LATENCY_TRACE_RING_SIZE 16
+#    endif
+
+// Every power of two is split into 2^LATENCY_TRACE_SUB_BUCKET_BITS buckets
+#    ifndef LATENCY_TRACE_SUB_BUCKET_BITS
+#        if defined(__AVR__)
+#            define LATENCY_TRACE_SUB_BUCKET_BITS 1
+#        else
+#            define LATENCY_TRACE_SUB_BUCKET_BITS 2
+#        endif
+#    endif
+
+// Samples of 2^LATENCY_TRACE_MAX_BITS ticks or more all land in the last bucket
+#    ifndef LATENCY_TRACE_MAX_BITS
+#        if defined(__AVR__)
+#            define LATENCY_TRACE_MAX_BITS 20
+#        else
+#            define LATENCY_TRACE_MAX_BITS 32
+#        endif
+#    endif
+
+// A report sent longer than this after the last key change isn't attributed to it
+#    ifndef LATENCY_TRACE_REPORT_TIMEOUT
+#        define LATENCY_TRACE_REPORT_TIMEOUT 100
+#    endif
+
+// Keys of the raw matrix whose first change is kept until debouncing catches up with it
+#    ifndef LATENCY_TRACE_RAW_CHANGES
+#        define LATENCY_TRACE_RAW_CHANGES 4
+#    endif
+
+#    ifndef LATENCY_TRACE_RAW_HID_ID
+#        define LATENCY_TRACE_RAW_HID_ID 0xF4
+#    endif
+
+#    define LATENCY_TRACE_SUB_BUCKETS (1 << LATENCY_TRACE_SUB_BUCKET_BITS)
+#    define LATENCY_TRACE_BUCKETS ((LATENCY_TRACE_MAX_BITS - LATENCY_TRACE_SUB_BUCKET_BITS + 1) * LATENCY_TRACE_SUB_BUCKETS)
+
+#    if (LATENCY_TRACE_RING_SIZE & (LATENCY_TRACE_RING_SIZE - 1)) != 0 || LATENCY_TRACE_RING_SIZE > 256
+#        error LATENCY_TRACE_RING_SIZE must be a power of two no larger than 256
+#    endif
+
+#    if LATENCY_TRACE_BUCKETS > 255
+#        error LATENCY_TRACE_SUB_BUCKET_BITS is too large
+#    endif
+
+#    define LATENCY_TRACE(stage, ...)                                                           \
+        do {                                                                                    \
+            const uint32_t latency_trace_start = latency_trace_timestamp();                     \
+            __VA_ARGS__;                                                                        \
+            latency_trace_record((stage), latency_trace_timestamp() - latency_trace_start);     \
+        } while (0)
+
+/**
+ * @brief Reads the high resolution counter the samples are measured in.
+ *
+ * Ticks are those of timer_read_ticks(): timer0 counts on AVR, the realtime
+ * counter on ChibiOS cores that have one, and milliseconds elsewhere.
+ */
+uint32_t latency_trace_timestamp(void);
+
+/**
+ * @brief Frequency of latency_trace_timestamp(), in Hz.
+ */
+uint32_t latency_trace_tick_frequency(void);
+
+/**
+ * @brief Queues one sample. Safe to call from a single interrupt-level
+ * producer while the main loop drains the ring.
+ */
+void latency_trace_record(latency_trace_stage_t stage, uint32_t ticks);
+
+/**
+ * @brief Moves queued samples into the histograms, and prints them every
+ * LATENCY_TRACE_PRINT_INTERVAL milliseconds when that is defined.
+ */
+void latency_trace_task(void);
+
+/**
+ * @brief Fills `stats` with the percentiles of `stage`, in ticks.
+ *
+ * Percentiles are reported as the upper bound of the histogram bucket they
+ * fall into, capped at the largest sample seen.
+ */
+void latency_trace_get_stats(latency_trace_stage_t stage, latency_trace_stats_t *stats);
+
+/**
+ * @brief Number of samples lost to a full ring since the last reset.
+ */
+uint16_t latency_trace_dropped(void);
+
+/**
+ * @brief Marks a key change, seen by the scan that started at `scan_start`.
+ *
+ * Only the most recent change is kept: it is the one the next report is
+ * attributed to.
+ */
+void latency_trace_scan_changed(uint32_t scan_start);
+
+/**
+ * @brief Marks the keys set in `changes` as changed in the raw matrix, before
+ * debouncing.
+ *
+ * Only the first raw change of a key is kept, so that contact bounce doesn't
+ * move it, until the debounced matrix catches up with the key.
+ */
+void latency_trace_raw_changed(uint8_t row, uint32_t changes);
+
+/**
+ * @brief Called for every key that changed in the debounced matrix, after
+ * latency_trace_scan_changed().
+ *
+ * Moves the start of the pending change back to the first raw change of the
+ * key, so the latency includes the time spent debouncing. Keys without a raw
+ * change, e.g. those of the other half of a split keyboard, keep the scan's
+ * start.
+ */
+void latency_trace_key_changed(uint8_t row, uint8_t col);
+
+/**
+ * @brief Called by the USB driver once a keyboard report has been queued, and
+ * records its latency from the last key change.
+ */
+void latency_trace_report_sent(void);
+
+/**
+ * @brief Number of key changes that timed out before a report went out, or
+ * were overtaken by a later change, since the last reset.
+ */
+uint16_t latency_trace_unmatched(void);
+
+/**
+ * @brief Name of the debounce algorithm the end-to-end latency was measured with.
+ */
+const char *latency_trace_debounce_type(void);
+
+/**
+ * @brief Bitmask of the latency_trace_feature_t built into the firmware.
+ */
+uint16_t latency_trace_features(void);
+
+void        latency_trace_reset(void);
+const char *latency_trace_stage_name(latency_trace_stage_t stage);
+void        latency_trace_print(void);
+
+/**
+ * @brief Handles a raw HID report addressed to LATENCY_TRACE_RAW_HID_ID.
+ *
+ * The reply is written back into `data`, and should be sent with
+ * raw_hid_send() by the caller.
+ *
+ * @return true if the report was a latency trace command
+ */
+bool latency_trace_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#else
+
+#    define LATENCY_TRACE(stage, ...) \
+        do {                          \
+            __VA_ARGS__;              \
+        } while (0)
+
+#endif // LATENCY_TRACE_ENABLE
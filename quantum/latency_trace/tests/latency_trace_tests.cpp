@@ -0,0 +1,250 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "latency_trace.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+class LatencyTraceTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        latency_trace_reset();
+    }
+
+    latency_trace_stats_t stats(latency_trace_stage_t stage) {
+        latency_trace_stats_t result;
+        latency_trace_task();
+        latency_trace_get_stats(stage, &result);
+        return result;
+    }
+
+    void record_all(latency_trace_stage_t stage, const std::vector<uint32_t> &samples) {
+        for (auto ticks : samples) {
+            latency_trace_record(stage, ticks);
+            latency_trace_task();
+        }
+    }
+};
+
+TEST_F(LatencyTraceTest, EmptyStageReportsNothing) {
+    latency_trace_stats_t result = stats(LATENCY_TRACE_DEBOUNCE);
+    EXPECT_EQ(result.count, 0);
+    EXPECT_EQ(result.p50, 0);
+    EXPECT_EQ(result.p99, 0);
+    EXPECT_EQ(result.max, 0);
+}
+
+TEST_F(LatencyTraceTest, SmallValuesAreExact) {
+    record_all(LATENCY_TRACE_DEBOUNCE, {1, 2, 3, 3});
+
+    latency_trace_stats_t result = stats(LATENCY_TRACE_DEBOUNCE);
+    EXPECT_EQ(result.count, 4);
+    EXPECT_EQ(result.p50, 2);
+    EXPECT_EQ(result.p99, 3);
+    EXPECT_EQ(result.max, 3);
+}
+
+TEST_F(LatencyTraceTest, RareSpikeShowsInTailOnly) {
+    std::vector<uint32_t> samples(199, 100);
+    samples.push_back(5000);
+    samples.push_back(5000);
+    samples.push_back(100000);
+    record_all(LATENCY_TRACE_MATRIX_SCAN, samples);
+
+    latency_trace_stats_t result = stats(LATENCY_TRACE_MATRIX_SCAN);
+    EXPECT_EQ(result.count, 202);
+    // Within one bucket of the real value
+    EXPECT_GE(result.p50, 100);
+    EXPECT_LT(result.p50, 128);
+    EXPECT_GE(result.p99, 5000);
+    EXPECT_LT(result.p99, 6144);
+    EXPECT_EQ(result.max, 100000);
+}
+
+TEST_F(LatencyTraceTest, StagesAreIndependent) {
+    record_all(LATENCY_TRACE_ACTION_EXEC, {10});
+    record_all(LATENCY_TRACE_HOST_KEYBOARD_SEND, {20, 20});
+
+    EXPECT_EQ(stats(LATENCY_TRACE_ACTION_EXEC).count, 1);
+    EXPECT_EQ(stats(LATENCY_TRACE_HOST_KEYBOARD_SEND).count, 2);
+    EXPECT_EQ(stats(LATENCY_TRACE_RGB_MATRIX_TASK).count, 0);
+}
+
+TEST_F(LatencyTraceTest, FullRingDropsSamples) {
+    // One slot is always kept free to tell a full ring from an empty one
+    for (int i = 0; i < 10; i++) {
+        latency_trace_record(LATENCY_TRACE_ACTION_EXEC, 1);
+    }
+
+    EXPECT_EQ(latency_trace_dropped(), 3);
+    EXPECT_EQ(stats(LATENCY_TRACE_ACTION_EXEC).count, 7);
+
+    // Draining made room again
+    latency_trace_record(LATENCY_TRACE_ACTION_EXEC, 1);
+    EXPECT_EQ(stats(LATENCY_TRACE_ACTION_EXEC).count, 8);
+    EXPECT_EQ(latency_trace_dropped(), 3);
+}
+
+TEST_F(LatencyTraceTest, ResetClearsEverything) {
+    for (int i = 0; i < 10; i++) {
+        latency_trace_record(LATENCY_TRACE_ACTION_EXEC, 1);
+    }
+    latency_trace_reset();
+
+    EXPECT_EQ(latency_trace_dropped(), 0);
+    EXPECT_EQ(stats(LATENCY_TRACE_ACTION_EXEC).count, 0);
+}
+
+TEST_F(LatencyTraceTest, SaturatedHistogramKeepsDistribution) {
+    for (uint32_t i = 0; i < 70000; i++) {
+        latency_trace_record(LATENCY_TRACE_PROCESS_RECORD_QUANTUM, (i % 100) ? 10 : 1000);
+        latency_trace_task();
+    }
+
+    latency_trace_stats_t result = stats(LATENCY_TRACE_PROCESS_RECORD_QUANTUM);
+    EXPECT_EQ(result.count, 70000);
+    EXPECT_LE(result.p50, 11);
+    EXPECT_GE(result.p99, 10);
+    EXPECT_EQ(result.max, 1000);
+}
+
+TEST_F(LatencyTraceTest, MacroTimesTheCall) {
+    LATENCY_TRACE(LATENCY_TRACE_RGB_MATRIX_TASK, advance_time(5));
+
+    latency_trace_stats_t result = stats(LATENCY_TRACE_RGB_MATRIX_TASK);
+    EXPECT_EQ(result.count, 1);
+    EXPECT_EQ(result.max, 5);
+}
+
+TEST_F(LatencyTraceTest, RawHidGetStage) {
+    record_all(LATENCY_TRACE_DEBOUNCE, {3, 3, 3});
+
+    uint8_t data[32] = {LATENCY_TRACE_RAW_HID_ID, 0x02, LATENCY_TRACE_DEBOUNCE};
+    EXPECT_TRUE(latency_trace_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[1], 0x02);
+
+    const uint8_t expected[] = {0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 3, 0, 0, 0, 3};
+    EXPECT_EQ(memcmp(&data[3], expected, sizeof(expected)), 0);
+}
+
+TEST_F(LatencyTraceTest, RawHidInfoAndErrors) {
+    uint8_t info[32] = {LATENCY_TRACE_RAW_HID_ID, 0x01};
+    EXPECT_TRUE(latency_trace_raw_hid_receive(info, sizeof(info)));
+    EXPECT_EQ(info[2], LATENCY_TRACE_STAGE_COUNT);
+    // The test platform counts milliseconds
+    EXPECT_EQ((info[7] << 8) | info[8], 1000);
+
+    uint8_t bad_stage[32] = {LATENCY_TRACE_RAW_HID_ID, 0x02, LATENCY_TRACE_STAGE_COUNT};
+    EXPECT_TRUE(latency_trace_raw_hid_receive(bad_stage, sizeof(bad_stage)));
+    EXPECT_EQ(bad_stage[1], 0xFF);
+
+    uint8_t other[32] = {0x01};
+    EXPECT_FALSE(latency_trace_raw_hid_receive(other, sizeof(other)));
+    EXPECT_EQ(other[0], 0x01);
+}
+
+TEST_F(LatencyTraceTest, ReportMatchedToLastChange) {
+    latency_trace_scan_changed(latency_trace_timestamp());
+    advance_time(3);
+    latency_trace_report_sent();
+
+    // Nothing pending anymore
+    latency_trace_report_sent();
+
+    latency_trace_stats_t result = stats(LATENCY_TRACE_SCAN_TO_REPORT);
+    EXPECT_EQ(result.count, 1);
+    EXPECT_EQ(result.max, 3);
+    EXPECT_EQ(latency_trace_unmatched(), 0);
+}
+
+TEST_F(LatencyTraceTest, StaleChangeIsUnmatched) {
+    latency_trace_scan_changed(latency_trace_timestamp());
+    advance_time(LATENCY_TRACE_REPORT_TIMEOUT + 1);
+    latency_trace_report_sent();
+
+    EXPECT_EQ(stats(LATENCY_TRACE_SCAN_TO_REPORT).count, 0);
+    EXPECT_EQ(latency_trace_unmatched(), 1);
+}
+
+TEST_F(LatencyTraceTest, OvertakenChangeIsUnmatched) {
+    latency_trace_scan_changed(latency_trace_timestamp());
+    advance_time(10);
+    latency_trace_scan_changed(latency_trace_timestamp());
+    advance_time(1);
+    latency_trace_report_sent();
+
+    latency_trace_stats_t result = stats(LATENCY_TRACE_SCAN_TO_REPORT);
+    EXPECT_EQ(result.count, 1);
+    EXPECT_EQ(result.max, 1);
+    EXPECT_EQ(latency_trace_unmatched(), 1);
+}
+
+TEST_F(LatencyTraceTest, ReportMeasuredFromRawChange) {
+    latency_trace_raw_changed(1, 1 << 2);
+    advance_time(5);
+
+    // Debounced five scans later
+    latency_trace_scan_changed(latency_trace_timestamp());
+    latency_trace_key_changed(1, 2);
+    advance_time(1);
+    latency_trace_report_sent();
+
+    latency_trace_stats_t result = stats(LATENCY_TRACE_SCAN_TO_REPORT);
+    EXPECT_EQ(result.count, 1);
+    EXPECT_EQ(result.max, 6);
+}
+
+TEST_F(LatencyTraceTest, BouncingKeyKeepsFirstRawChange) {
+    latency_trace_raw_changed(0, 1 << 3);
+    advance_time(1);
+    latency_trace_raw_changed(0, 1 << 3);
+    advance_time(1);
+    latency_trace_raw_changed(0, 1 << 3);
+    advance_time(3);
+
+    latency_trace_scan_changed(latency_trace_timestamp());
+    latency_trace_key_changed(0, 3);
+    latency_trace_report_sent();
+
+    EXPECT_EQ(stats(LATENCY_TRACE_SCAN_TO_REPORT).max, 5);
+}
+
+TEST_F(LatencyTraceTest, FilteredRawChangeIsForgotten) {
+    // A glitch that debouncing never let through
+    latency_trace_raw_changed(0, 1 << 0);
+    advance_time(LATENCY_TRACE_REPORT_TIMEOUT + 1);
+
+    latency_trace_raw_changed(0, 1 << 0);
+    advance_time(2);
+    latency_trace_scan_changed(latency_trace_timestamp());
+    latency_trace_key_changed(0, 0);
+    latency_trace_report_sent();
+
+    EXPECT_EQ(stats(LATENCY_TRACE_SCAN_TO_REPORT).max, 2);
+}
+
+TEST_F(LatencyTraceTest, KeyWithoutRawChangeKeepsScanStart) {
+    latency_trace_raw_changed(0, 1 << 1);
+    advance_time(5);
+
+    // e.g. a key of the other half of a split keyboard
+    latency_trace_scan_changed(latency_trace_timestamp());
+    latency_trace_key_changed(0, 4);
+    advance_time(1);
+    latency_trace_report_sent();
+
+    EXPECT_EQ(stats(LATENCY_TRACE_SCAN_TO_REPORT).max, 1);
+}
+
+TEST_F(LatencyTraceTest, RawHidGetBuild) {
+    uint8_t data[32] = {LATENCY_TRACE_RAW_HID_ID, 0x04};
+    EXPECT_TRUE(latency_trace_raw_hid_receive(data, sizeof(data)));
+    EXPECT_STREQ((const char *)&data[6], "unknown");
+}
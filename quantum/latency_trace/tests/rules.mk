@@ -0,0 +1,6 @@
+latency_trace_histogram_DEFS := -DLATENCY_TRACE_ENABLE -DLATENCY_TRACE_RING_SIZE=8
+
+latency_trace_histogram_SRC := \
+    $(QUANTUM_PATH)/latency_trace/tests/latency_trace_tests.cpp \
+    $(QUANTUM_PATH)/latency_trace.c \
+    $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
@@ -31,6 +31,10 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef LED_MATRIX_RENDER_BUDGET_US
+#    include "timer.h"
+#endif
+
 #ifndef LED_MATRIX_CENTER
 const led_point_t k_led_matrix_center = {112, 32};
 #else
@@ -67,6 +71,9 @@ uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
+#ifdef LED_MATRIX_GEOMETRY_CACHE
+led_geometry_t g_led_matrix_geometry[LED_MATRIX_LED_COUNT];
+#endif // LED_MATRIX_GEOMETRY_CACHE
 
 // internals
 static bool            suspend_state     = false;
@@ -77,6 +84,11 @@ static led_task_states led_task_state    = SYNCING;
 #if LED_MATRIX_TIMEOUT > 0
 static uint32_t led_anykey_timer;
 #endif // LED_MATRIX_TIMEOUT > 0
+#ifdef LED_MATRIX_RENDER_BUDGET_US
+static uint8_t                    led_render_chunk = LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < LED_MATRIX_LED_COUNT ? LED_MATRIX_LED_PROCESS_LIMIT : LED_MATRIX_LED_COUNT;
+static uint8_t                    led_render_next;
+static struct led_matrix_limits_t led_render_limits;
+#endif // LED_MATRIX_RENDER_BUDGET_US
 
 // double buffers
 static uint32_t led_timer_buffer;
@@ -243,9 +255,44 @@ static void led_task_sync(void) {
     if (sync_timer_elapsed32(g_led_timer) >= LED_MATRIX_LED_FLUSH_LIMIT) led_task_state = STARTING;
 }
 
+#ifdef LED_MATRIX_RENDER_BUDGET_US
+static void led_render_next_limits(void) {
+    uint16_t max = led_render_next + led_render_chunk;
+
+    led_render_limits.led_min_index = led_render_next;
+    led_render_limits.led_max_index = max > LED_MATRIX_LED_COUNT ? LED_MATRIX_LED_COUNT : max;
+#    if defined(LED_MATRIX_SPLIT)
+    if (is_keyboard_left() && (led_render_limits.led_max_index > k_led_matrix_split[0])) led_render_limits.led_max_index = k_led_matrix_split[0];
+#    endif
+    led_render_next = led_render_limits.led_max_index;
+}
+
+static void led_render_adapt(uint32_t elapsed) {
+    // Millisecond ticks are far too coarse to size chunks that take a fraction of one, keep the initial chunk size
+    if (timer_ticks_frequency() <= 1000 || led_render_limits.led_max_index <= led_render_limits.led_min_index) {
+        return;
+    }
+    uint8_t leds = led_render_limits.led_max_index - led_render_limits.led_min_index;
+
+    // Number of LEDs that would have fit into the budget, at the cost measured for this chunk
+    uint32_t fit = elapsed > 0 ? (uint32_t)leds * LED_MATRIX_RENDER_BUDGET_US / elapsed : LED_MATRIX_LED_COUNT;
+    if (fit < 1) fit = 1;
+    if (fit > LED_MATRIX_LED_COUNT) fit = LED_MATRIX_LED_COUNT;
+
+    // Back off straight away when over budget, but only grow halfway towards the estimate
+    led_render_chunk = fit < led_render_chunk ? fit : (led_render_chunk + fit + 1) / 2;
+}
+#endif // LED_MATRIX_RENDER_BUDGET_US
+
 static void led_task_start(void) {
     // reset iter
     led_effect_params.iter = 0;
+#ifdef LED_MATRIX_RENDER_BUDGET_US
+    led_render_next = 0;
+#    if defined(LED_MATRIX_SPLIT)
+    if (!is_keyboard_left()) led_render_next = k_led_matrix_split[0];
+#    endif
+#endif // LED_MATRIX_RENDER_BUDGET_US
 
     // update double buffers
     g_led_timer = led_timer_buffer;
@@ -265,6 +312,10 @@ static void led_task_render(uint8_t effect) {
         led_matrix_set_value_all(0);
     }
 
+#ifdef LED_MATRIX_RENDER_BUDGET_US
+    led_render_next_limits();
+#endif // LED_MATRIX_RENDER_BUDGET_US
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -339,7 +390,10 @@ void led_matrix_task(void) {
         case STARTING:
             led_task_start();
             break;
-        case RENDERING:
+        case RENDERING: {
+#ifdef LED_MATRIX_RENDER_BUDGET_US
+            uint32_t render_start = timer_read_ticks();
+#endif // LED_MATRIX_RENDER_BUDGET_US
             led_task_render(effect);
             if (effect) {
                 if (led_task_state == FLUSHING) {
@@ -347,7 +401,11 @@ void led_matrix_task(void) {
                 }
                 led_matrix_indicators_advanced(&led_effect_params);
             }
+#ifdef LED_MATRIX_RENDER_BUDGET_US
+            led_render_adapt(timer_ticks_to_us(timer_read_ticks() - render_start));
+#endif // LED_MATRIX_RENDER_BUDGET_US
             break;
+        }
         case FLUSHING:
             led_task_flush(effect);
             break;
@@ -389,7 +447,11 @@ __attribute__((weak)) bool led_matrix_indicators_advanced_user(uint8_t led_min,
 
 struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
     struct led_matrix_limits_t limits = {0};
-#if defined(LED_MATRIX_LED_PROCESS_LIMIT) && LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < LED_MATRIX_LED_COUNT
+#if defined(LED_MATRIX_RENDER_BUDGET_US)
+    // Chunks are sized at runtime, so only the one being rendered is known
+    (void)iter;
+    limits = led_render_limits;
+#elif defined(LED_MATRIX_LED_PROCESS_LIMIT) && LED_MATRIX_LED_PROCESS_LIMIT > 0 && LED_MATRIX_LED_PROCESS_LIMIT < LED_MATRIX_LED_COUNT
 #    if defined(LED_MATRIX_SPLIT)
     limits.led_min_index = LED_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + LED_MATRIX_LED_PROCESS_LIMIT;
@@ -417,9 +479,25 @@ struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
     return limits;
 }
 
+#ifdef LED_MATRIX_GEOMETRY_CACHE
+void led_matrix_update_geometry(void) {
+    for (uint8_t i = 0; i < LED_MATRIX_LED_COUNT; i++) {
+        int16_t dx = g_led_config.point[i].x - k_led_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_led_matrix_center.y;
+
+        g_led_matrix_geometry[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_led_matrix_geometry[i].angle = atan2_8(dy, dx);
+    }
+}
+#endif // LED_MATRIX_GEOMETRY_CACHE
+
 void led_matrix_init(void) {
     led_matrix_driver.init();
 
+#ifdef LED_MATRIX_GEOMETRY_CACHE
+    led_matrix_update_geometry();
+#endif // LED_MATRIX_GEOMETRY_CACHE
+
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
@@ -159,6 +159,10 @@ bool led_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void led_matrix_init(void);
 
+#ifdef LED_MATRIX_GEOMETRY_CACHE
+void led_matrix_update_geometry(void);
+#endif
+
 void        led_matrix_set_suspend_state(bool state);
 bool        led_matrix_get_suspend_state(void);
 void        led_matrix_toggle(void);
@@ -226,6 +230,9 @@ extern led_config_t g_led_config;
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
+#ifdef LED_MATRIX_GEOMETRY_CACHE
+extern led_geometry_t g_led_matrix_geometry[LED_MATRIX_LED_COUNT];
+#endif
 #ifdef LED_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
@@ -20,6 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "util.h"
 #include "matrix.h"
 #include "debounce.h"
+#include "latency_trace.h"
 #include "atomic_util.h"
 
 #ifdef SPLIT_KEYBOARD
@@ -27,8 +28,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "split_common/transactions.h"
 
 #    define ROWS_PER_HAND (MATRIX_ROWS / 2)
+#    define THIS_HAND_ROW(row) (thisHand + (row))
 #else
 #    define ROWS_PER_HAND (MATRIX_ROWS)
+#    define THIS_HAND_ROW(row) (row)
 #endif
 
 #ifdef DIRECT_PINS_RIGHT
@@ -336,14 +339,27 @@ uint8_t matrix_scan(void) {
     }
 #endif
 
-    bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
-    if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
+    bool changed = false;
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (raw_matrix[row] != curr_matrix[row]) {
+#ifdef LATENCY_TRACE_ENABLE
+            latency_trace_raw_changed(THIS_HAND_ROW(row), raw_matrix[row] ^ curr_matrix[row]);
+#endif
+            raw_matrix[row] = curr_matrix[row];
+            changed         = true;
+        }
+    }
 
 #ifdef SPLIT_KEYBOARD
-    changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
+    matrix_dirty_rows_begin(thisHand);
+    LATENCY_TRACE(LATENCY_TRACE_DEBOUNCE, changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed));
+    matrix_dirty_rows_end(ROWS_PER_HAND, changed);
+    changed |= matrix_post_scan();
 #else
-    changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
-    matrix_scan_kb();
+    matrix_dirty_rows_begin(0);
+    LATENCY_TRACE(LATENCY_TRACE_DEBOUNCE, changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed));
+    matrix_dirty_rows_end(ROWS_PER_HAND, changed);
+    matrix_scan_hook_dirty(matrix_scan_kb);
 #endif
     return (uint8_t)changed;
 }
@@ -37,6 +37,18 @@ typedef uint32_t matrix_row_t;
 
 #define MATRIX_ROW_SHIFTER ((matrix_row_t)1)
 
+/* bitmap of rows, one bit per row, split into words for count-trailing-zeros iteration */
+#if (MATRIX_ROWS <= 8)
+typedef uint8_t matrix_dirty_t;
+#elif (MATRIX_ROWS <= 16)
+typedef uint16_t matrix_dirty_t;
+#else
+typedef uint32_t matrix_dirty_t;
+#endif
+
+#define MATRIX_DIRTY_BITS (sizeof(matrix_dirty_t) * 8)
+#define MATRIX_DIRTY_WORDS ((MATRIX_ROWS + MATRIX_DIRTY_BITS - 1) / MATRIX_DIRTY_BITS)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -65,6 +77,12 @@ void matrix_output_unselect_delay(uint8_t line, bool key_pressed);
 /* only for backwards compatibility. delay between changing matrix pin state and reading values */
 void matrix_io_delay(void);
 
+/* dirty row tracking, lets matrix_task() visit only the rows the last scan changed */
+void matrix_dirty_rows_begin(uint8_t offset);
+void matrix_dirty_rows_end(uint8_t num_rows, bool changed);
+void matrix_set_row_dirty(uint8_t row);
+void matrix_scan_hook_dirty(void (*hook)(void));
+
 /* power control */
 void matrix_power_up(void);
 void matrix_power_down(void);
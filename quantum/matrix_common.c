@@ -1,5 +1,7 @@
+#include <string.h>
 #include "matrix.h"
 #include "debounce.h"
+#include "latency_trace.h"
 #include "wait.h"
 #include "print.h"
 #include "debug.h"
@@ -7,11 +9,12 @@
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
 #    include "split_common/transactions.h"
-#    include <string.h>
 
 #    define ROWS_PER_HAND (MATRIX_ROWS / 2)
+#    define THIS_HAND_ROW(row) (thisHand + (row))
 #else
 #    define ROWS_PER_HAND (MATRIX_ROWS)
+#    define THIS_HAND_ROW(row) (row)
 #endif
 
 #ifndef MATRIX_IO_DELAY
@@ -45,6 +48,24 @@ __attribute__((weak)) void matrix_init_user(void) {}
 
 __attribute__((weak)) void matrix_scan_user(void) {}
 
+/** \brief Runs a matrix scan hook, marking the rows it changed as dirty
+ *
+ * Keyboards may write to the debounced matrix from matrix_scan_kb() and friends,
+ * after debounce has already reported the rows it changed.
+ */
+void matrix_scan_hook_dirty(void (*hook)(void)) {
+    matrix_row_t previous[MATRIX_ROWS];
+    memcpy(previous, matrix, sizeof(previous));
+
+    hook();
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix[row] != previous[row]) {
+            matrix_set_row_dirty(row);
+        }
+    }
+}
+
 // helper functions
 
 inline uint8_t matrix_rows(void) {
@@ -109,13 +130,26 @@ bool matrix_post_scan(void) {
             last_connected = false;
         }
 
-        if (changed) memcpy(matrix + thatHand, slave_matrix, sizeof(slave_matrix));
+        if (changed) {
+            for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+                if (matrix[thatHand + row] != slave_matrix[row]) {
+                    matrix[thatHand + row] = slave_matrix[row];
+                    matrix_set_row_dirty(thatHand + row);
+                }
+            }
+        }
 
-        matrix_scan_kb();
+        matrix_scan_hook_dirty(matrix_scan_kb);
     } else {
         transport_slave(matrix + thatHand, matrix + thisHand);
+#    ifdef SPLIT_TRANSPORT_MIRROR
+        // the mirrored master half is written behind our back by the transport
+        for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+            matrix_set_row_dirty(thatHand + row);
+        }
+#    endif
 
-        matrix_slave_scan_kb();
+        matrix_scan_hook_dirty(matrix_slave_scan_kb);
     }
 
     return changed;
@@ -166,13 +200,33 @@ __attribute__((weak)) void matrix_init(void) {
 }
 
 __attribute__((weak)) uint8_t matrix_scan(void) {
+#ifdef LATENCY_TRACE_ENABLE
+    matrix_row_t previous_raw[ROWS_PER_HAND];
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        previous_raw[row] = raw_matrix[row];
+    }
+#endif
+
     bool changed = matrix_scan_custom(raw_matrix);
 
+#ifdef LATENCY_TRACE_ENABLE
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        if (raw_matrix[row] != previous_raw[row]) {
+            latency_trace_raw_changed(THIS_HAND_ROW(row), raw_matrix[row] ^ previous_raw[row]);
+        }
+    }
+#endif
+
 #ifdef SPLIT_KEYBOARD
-    changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
+    matrix_dirty_rows_begin(thisHand);
+    LATENCY_TRACE(LATENCY_TRACE_DEBOUNCE, changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed));
+    matrix_dirty_rows_end(ROWS_PER_HAND, changed);
+    changed |= matrix_post_scan();
 #else
-    changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
-    matrix_scan_kb();
+    matrix_dirty_rows_begin(0);
+    LATENCY_TRACE(LATENCY_TRACE_DEBOUNCE, changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed));
+    matrix_dirty_rows_end(ROWS_PER_HAND, changed);
+    matrix_scan_hook_dirty(matrix_scan_kb);
 #endif
 
     return changed;
@@ -16,6 +16,8 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
+#include "debug.h"
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -94,6 +96,20 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#if COMBO_INDEX_LENGTH > 0
+/* Every keycode used by a combo, paired with each combo it is part of.
+ * Sorted by keycode, then by combo index, so that a key event only needs
+ * to visit its own run of entries, in the same order as a full scan would. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_index_entry_t;
+static combo_index_entry_t combo_index[COMBO_INDEX_LENGTH];
+static uint16_t            combo_index_size  = 0;
+static uint16_t            combo_index_count = 0; // combo_count() the index was built for
+static bool                combo_index_valid = false;
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -256,7 +272,70 @@ static inline void dump_key_buffer(void) {
     key_buffer_next = key_buffer_size = 0;
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == COMBO_STATE(combo))
+#if COMBO_INDEX_LENGTH > 0
+static bool combo_index_insert(uint16_t keycode, uint16_t combo_index_value) {
+    uint16_t i = combo_index_size;
+
+    // Combos are added in order, so an equal keycode always goes after the existing entries
+    while (i > 0 && combo_index[i - 1].keycode > keycode) {
+        i--;
+    }
+
+    // Keycode listed twice in the same combo
+    if (i > 0 && combo_index[i - 1].keycode == keycode && combo_index[i - 1].combo_index == combo_index_value) {
+        return true;
+    }
+
+    if (combo_index_size >= COMBO_INDEX_LENGTH) {
+        return false;
+    }
+
+    memmove(&combo_index[i + 1], &combo_index[i], (combo_index_size - i) * sizeof(combo_index_entry_t));
+    combo_index[i] = (combo_index_entry_t){.keycode = keycode, .combo_index = combo_index_value};
+    combo_index_size++;
+
+    return true;
+}
+
+/* First entry for `keycode`, or combo_index_size if no combo uses it. */
+static uint16_t combo_index_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_index_size;
+
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_index[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+#endif
+
+void combo_init(void) {
+#if COMBO_INDEX_LENGTH > 0
+    combo_index_size  = 0;
+    combo_index_count = combo_count();
+    combo_index_valid = false;
+
+    for (uint16_t idx = 0; idx < combo_index_count; ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+
+        for (uint8_t i = 0; (key = pgm_read_word(&keys[i])) != COMBO_END; ++i) {
+            if (!combo_index_insert(key, idx)) {
+                dprintf("combo: index full, raise COMBO_INDEX_LENGTH above %u\n", COMBO_INDEX_LENGTH);
+                return;
+            }
+        }
+    }
+
+    combo_index_valid = true;
+#endif
+}
+
 #define ALL_COMBO_KEYS_ARE_DOWN(state, key_count) (((1 << key_count) - 1) == state)
 #define ONLY_ONE_KEY_IS_DOWN(state) !(state & (state - 1))
 #define KEY_NOT_YET_RELEASED(state, key_index) ((1 << key_index) & state)
@@ -535,8 +614,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 }
 
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -564,10 +642,24 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#if COMBO_INDEX_LENGTH > 0
+    // combo_count() can be overridden, pick up a changed set of combos
+    if (combo_index_count != combo_count()) {
+        combo_init();
+    }
+
+    if (combo_index_valid) {
+        // Combos that don't contain the keycode are left untouched by process_single_combo()
+        for (uint16_t i = combo_index_find(keycode); i < combo_index_size && combo_index[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_index[i].combo_index;
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
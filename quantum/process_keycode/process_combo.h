@@ -38,6 +38,12 @@
 #ifndef COMBO_BUFFER_LENGTH
 #    define COMBO_BUFFER_LENGTH 4
 #endif
+/* Number of keycode to combo pairs in the index, 0 checks every combo.
+ * Layouts with more keys across all their combos fall back to checking
+ * every combo. */
+#ifndef COMBO_INDEX_LENGTH
+#    define COMBO_INDEX_LENGTH 0
+#endif
 
 typedef struct combo_t {
     const uint16_t *keys;
@@ -73,6 +79,7 @@ typedef struct combo_t {
 /* check if keycode is only modifiers */
 #define KEYCODE_IS_MOD(code) (IS_MODIFIER_KEYCODE(code) || (IS_QK_MODS(code) && !QK_MODS_GET_BASIC_KEYCODE(code)))
 
+void combo_init(void);
 bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
 void process_combo_event(uint16_t combo_index, bool pressed);
@@ -68,6 +68,14 @@
 #    include "process_unicode_common.h"
 #endif
 
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION)
+#    include "wear_leveling.h"
+#endif
+
+#if defined(EEPROM_DRIVER) && defined(EEPROM_WRITE_BACK)
+#    include "eeprom_driver.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -191,9 +199,24 @@ void shutdown_quantum(bool jump_to_bootloader) {
     shutdown_kb(jump_to_bootloader);
     wait_ms(250);
 #endif
+#if defined(ISSI_INCREMENTAL_FLUSH) && (defined(LED_MATRIX_ENABLE) || defined(RGB_MATRIX_ENABLE))
+    // let the last frame reach the LED drivers
+    issi_incremental_flush_wait();
+#endif
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    // drop an unfinished transaction, its data never got checked
+    dynamic_keymap_end_transaction(false);
+    dynamic_keymap_flush();
+#endif
+#if defined(EEPROM_DRIVER) && defined(EEPROM_WRITE_BACK)
+    eeprom_driver_flush();
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION)
+    wear_leveling_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -234,10 +257,18 @@ uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache) {
         } else {
             layer = read_source_layers_cache(event.key);
         }
+#ifdef KEYCODE_CACHE_ENABLE
+        return keycode_cache_get_keycode(layer, event.key);
+#else
         return keymap_key_to_keycode(layer, event.key);
+#endif
     } else
 #endif
+#ifdef KEYCODE_CACHE_ENABLE
+        return keycode_cache_get_keycode(layer_switch_get_layer(event.key), event.key);
+#else
         return keymap_key_to_keycode(layer_switch_get_layer(event.key), event.key);
+#endif
 }
 
 /* Get keycode, and then process pre tapping functionality */
@@ -504,6 +535,12 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_flush();
+#endif
+#if defined(EEPROM_DRIVER) && defined(EEPROM_WRITE_BACK)
+    eeprom_driver_flush();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
@@ -536,6 +573,9 @@ void suspend_power_down_quantum(void) {
 #    if defined(RGB_MATRIX_ENABLE)
     rgb_matrix_set_suspend_state(true);
 #    endif
+#    if defined(ISSI_INCREMENTAL_FLUSH) && (defined(LED_MATRIX_ENABLE) || defined(RGB_MATRIX_ENABLE))
+    issi_incremental_flush_wait();
+#    endif
 
 #    ifdef OLED_ENABLE
     oled_off();
@@ -29,6 +29,10 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+#    include "timer.h"
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
@@ -69,6 +73,9 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+led_geometry_t g_rgb_matrix_geometry[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_GEOMETRY_CACHE
 
 // internals
 static bool            suspend_state     = false;
@@ -79,6 +86,11 @@ static rgb_task_states rgb_task_state    = SYNCING;
 #if RGB_MATRIX_TIMEOUT > 0
 static uint32_t rgb_anykey_timer;
 #endif // RGB_MATRIX_TIMEOUT > 0
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+static uint8_t                    rgb_render_chunk = RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT ? RGB_MATRIX_LED_PROCESS_LIMIT : RGB_MATRIX_LED_COUNT;
+static uint8_t                    rgb_render_next;
+static struct rgb_matrix_limits_t rgb_render_limits;
+#endif // RGB_MATRIX_RENDER_BUDGET_US
 
 // double buffers
 static uint32_t rgb_timer_buffer;
@@ -277,9 +289,44 @@ static void rgb_task_sync(void) {
     if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
 }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+static void rgb_render_next_limits(void) {
+    uint16_t max = rgb_render_next + rgb_render_chunk;
+
+    rgb_render_limits.led_min_index = rgb_render_next;
+    rgb_render_limits.led_max_index = max > RGB_MATRIX_LED_COUNT ? RGB_MATRIX_LED_COUNT : max;
+#    if defined(RGB_MATRIX_SPLIT)
+    if (is_keyboard_left() && (rgb_render_limits.led_max_index > k_rgb_matrix_split[0])) rgb_render_limits.led_max_index = k_rgb_matrix_split[0];
+#    endif
+    rgb_render_next = rgb_render_limits.led_max_index;
+}
+
+static void rgb_render_adapt(uint32_t elapsed) {
+    // Millisecond ticks are far too coarse to size chunks that take a fraction of one, keep the initial chunk size
+    if (timer_ticks_frequency() <= 1000 || rgb_render_limits.led_max_index <= rgb_render_limits.led_min_index) {
+        return;
+    }
+    uint8_t leds = rgb_render_limits.led_max_index - rgb_render_limits.led_min_index;
+
+    // Number of LEDs that would have fit into the budget, at the cost measured for this chunk
+    uint32_t fit = elapsed > 0 ? (uint32_t)leds * RGB_MATRIX_RENDER_BUDGET_US / elapsed : RGB_MATRIX_LED_COUNT;
+    if (fit < 1) fit = 1;
+    if (fit > RGB_MATRIX_LED_COUNT) fit = RGB_MATRIX_LED_COUNT;
+
+    // Back off straight away when over budget, but only grow halfway towards the estimate
+    rgb_render_chunk = fit < rgb_render_chunk ? fit : (rgb_render_chunk + fit + 1) / 2;
+}
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
 static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    rgb_render_next = 0;
+#    if defined(RGB_MATRIX_SPLIT)
+    if (!is_keyboard_left()) rgb_render_next = k_rgb_matrix_split[0];
+#    endif
+#endif // RGB_MATRIX_RENDER_BUDGET_US
 
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
@@ -299,6 +346,10 @@ static void rgb_task_render(uint8_t effect) {
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+    rgb_render_next_limits();
+#endif // RGB_MATRIX_RENDER_BUDGET_US
+
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
     switch (effect) {
@@ -380,7 +431,10 @@ void rgb_matrix_task(void) {
         case STARTING:
             rgb_task_start();
             break;
-        case RENDERING:
+        case RENDERING: {
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+            uint32_t render_start = timer_read_ticks();
+#endif // RGB_MATRIX_RENDER_BUDGET_US
             rgb_task_render(effect);
             if (effect) {
                 if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
@@ -388,7 +442,11 @@ void rgb_matrix_task(void) {
                 }
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
             }
+#ifdef RGB_MATRIX_RENDER_BUDGET_US
+            rgb_render_adapt(timer_ticks_to_us(timer_read_ticks() - render_start));
+#endif // RGB_MATRIX_RENDER_BUDGET_US
             break;
+        }
         case FLUSHING:
             rgb_task_flush(effect);
             break;
@@ -412,7 +470,11 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if defined(RGB_MATRIX_RENDER_BUDGET_US)
+    // Chunks are sized at runtime, so only the one being rendered is known
+    (void)iter;
+    limits = rgb_render_limits;
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
 #    if defined(RGB_MATRIX_SPLIT)
     limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
     limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
@@ -458,9 +520,25 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
     return true;
 }
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+void rgb_matrix_update_geometry(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+
+        g_rgb_matrix_geometry[i].dist  = sqrt16(dx * dx + dy * dy);
+        g_rgb_matrix_geometry[i].angle = atan2_8(dy, dx);
+    }
+}
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    rgb_matrix_update_geometry();
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
@@ -0,0 +1,163 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+
+#    include <string.h>
+
+#    include "link_stats.h"
+#    include "transactions.h"
+#    include "timer.h"
+#    include "print.h"
+
+typedef struct {
+    uint32_t success;
+    uint32_t timeout;
+    uint32_t checksum_error;
+    uint32_t bytes;
+    uint64_t rtt_total;
+    uint32_t rtt_max;
+} link_counters_t;
+
+static link_counters_t counters[NUM_TOTAL_TRANSACTIONS];
+
+void split_link_stats_record(int8_t transaction_id, bool success, uint32_t rtt) {
+    if (transaction_id < 0 || transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+        return;
+    }
+
+    link_counters_t *c = &counters[transaction_id];
+    if (!success) {
+        c->timeout++;
+        return;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[transaction_id];
+    c->success++;
+    c->bytes += trans->initiator2target_buffer_size + trans->target2initiator_buffer_size;
+    c->rtt_total += rtt;
+    if (rtt > c->rtt_max) {
+        c->rtt_max = rtt;
+    }
+}
+
+void split_link_stats_checksum_error(int8_t transaction_id) {
+    if (transaction_id >= 0 && transaction_id < NUM_TOTAL_TRANSACTIONS) {
+        counters[transaction_id].checksum_error++;
+    }
+}
+
+void split_link_stats_get(int8_t transaction_id, split_link_stats_t *stats) {
+    memset(stats, 0, sizeof(split_link_stats_t));
+    if (transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+        return;
+    }
+
+    uint64_t rtt_total = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        if (transaction_id >= 0 && id != transaction_id) {
+            continue;
+        }
+
+        link_counters_t *c = &counters[id];
+        stats->success += c->success;
+        stats->timeout += c->timeout;
+        stats->checksum_error += c->checksum_error;
+        stats->bytes += c->bytes;
+        rtt_total += c->rtt_total;
+        if (c->rtt_max > stats->rtt_max) {
+            stats->rtt_max = c->rtt_max;
+        }
+    }
+
+    if (stats->success) {
+        stats->rtt_mean = rtt_total / stats->success;
+    }
+}
+
+void split_link_stats_reset(void) {
+    memset(counters, 0, sizeof(counters));
+}
+
+void split_link_stats_print(void) {
+    split_link_stats_t stats;
+    split_link_stats_get(-1, &stats);
+    uprintf("split link: ok=%lu timeout=%lu crc=%lu bytes=%lu\n", (unsigned long)stats.success, (unsigned long)stats.timeout, (unsigned long)stats.checksum_error, (unsigned long)stats.bytes);
+
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        split_link_stats_get(id, &stats);
+        if (!stats.success && !stats.timeout) {
+            continue;
+        }
+
+        uprintf("%d: ok=%lu timeout=%lu crc=%lu bytes=%lu rtt=%lu/%lu us\n", id, (unsigned long)stats.success, (unsigned long)stats.timeout, (unsigned long)stats.checksum_error, (unsigned long)stats.bytes, (unsigned long)stats.rtt_mean, (unsigned long)stats.rtt_max);
+    }
+}
+
+void split_link_stats_task(void) {
+#    ifdef SPLIT_LINK_STATS_PRINT_INTERVAL
+    static uint32_t last_print = 0;
+    if (timer_elapsed32(last_print) > SPLIT_LINK_STATS_PRINT_INTERVAL) {
+        split_link_stats_print();
+        last_print = timer_read32();
+    }
+#    endif
+}
+
+static void split_link_stats_write_u32(uint8_t *data, uint32_t value) {
+    data[0] = (value >> 24) & 0xFF;
+    data[1] = (value >> 16) & 0xFF;
+    data[2] = (value >> 8) & 0xFF;
+    data[3] = value & 0xFF;
+}
+
+enum split_link_stats_command {
+    split_link_stats_get_info        = 0x01,
+    split_link_stats_get_transaction = 0x02,
+    split_link_stats_clear           = 0x03,
+    split_link_stats_error           = 0xFF,
+};
+
+bool split_link_stats_raw_hid_receive(uint8_t *data, uint8_t length) {
+    // data = [ SPLIT_LINK_STATS_RAW_HID_ID, command, payload... ], replies use big endian values
+    if (length < 27 || data[0] != SPLIT_LINK_STATS_RAW_HID_ID) {
+        return false;
+    }
+
+    switch (data[1]) {
+        case split_link_stats_get_info: {
+            // [ id, command, transaction count ]
+            data[2] = NUM_TOTAL_TRANSACTIONS;
+            break;
+        }
+        case split_link_stats_get_transaction: {
+            // [ id, command, transaction id or 0xFF for all, success (4), timeout (4), checksum error (4), bytes (4), mean rtt (4), max rtt (4) ]
+            if (data[2] != 0xFF && data[2] >= NUM_TOTAL_TRANSACTIONS) {
+                data[1] = split_link_stats_error;
+                break;
+            }
+
+            split_link_stats_t stats;
+            split_link_stats_get(data[2] == 0xFF ? -1 : (int8_t)data[2], &stats);
+            split_link_stats_write_u32(&data[3], stats.success);
+            split_link_stats_write_u32(&data[7], stats.timeout);
+            split_link_stats_write_u32(&data[11], stats.checksum_error);
+            split_link_stats_write_u32(&data[15], stats.bytes);
+            split_link_stats_write_u32(&data[19], stats.rtt_mean);
+            split_link_stats_write_u32(&data[23], stats.rtt_max);
+            break;
+        }
+        case split_link_stats_clear: {
+            split_link_stats_reset();
+            break;
+        }
+        default: {
+            data[1] = split_link_stats_error;
+            break;
+        }
+    }
+
+    return true;
+}
+
+#endif // SPLIT_LINK_STATS_ENABLE
@@ -0,0 +1,70 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Split link statistics, enabled with SPLIT_LINK_STATS_ENABLE in config.h.
+
+    The master counts, for every transaction ID, how many transactions made it
+    across the link, how many failed or timed out, how many arrived with a bad
+    checksum, how many bytes they moved and how long they took. These can be
+    read from user code, printed over console, or queried over raw HID.
+
+    Transactions folded into a SPLIT_TRANSACTION_BATCHING exchange are counted
+    under EXCHANGE_BATCH or GET_BATCH_REPLY, as that's what went over the wire.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    uint32_t success;        // completed on the wire, including those with a bad checksum
+    uint32_t timeout;        // failed or timed out on the wire
+    uint32_t checksum_error; // completed, but the data didn't match its checksum
+    uint32_t bytes;          // moved in either direction by the completed ones
+    uint32_t rtt_mean;       // round trip time of the completed ones, in microseconds
+    uint32_t rtt_max;
+} split_link_stats_t;
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+
+#    ifndef SPLIT_LINK_STATS_RAW_HID_ID
+#        define SPLIT_LINK_STATS_RAW_HID_ID 0xF5
+#    endif
+
+/**
+ * @brief Accounts for one transaction, called by the split transactions on the master.
+ */
+void split_link_stats_record(int8_t transaction_id, bool success, uint32_t rtt);
+
+/**
+ * @brief Accounts for a transaction whose data didn't match its checksum.
+ */
+void split_link_stats_checksum_error(int8_t transaction_id);
+
+/**
+ * @brief Fills `stats` with the counters of `transaction_id`, or with the
+ * totals of all transactions if it is negative.
+ */
+void split_link_stats_get(int8_t transaction_id, split_link_stats_t *stats);
+
+void split_link_stats_reset(void);
+void split_link_stats_print(void);
+
+/**
+ * @brief Prints the counters every SPLIT_LINK_STATS_PRINT_INTERVAL
+ * milliseconds, when that is defined.
+ */
+void split_link_stats_task(void);
+
+/**
+ * @brief Handles a raw HID report addressed to SPLIT_LINK_STATS_RAW_HID_ID.
+ *
+ * The reply is written back into `data`, and should be sent with
+ * raw_hid_send() by the caller.
+ *
+ * @return true if the report was a link statistics command
+ */
+bool split_link_stats_raw_hid_receive(uint8_t *data, uint8_t length);
+
+#endif // SPLIT_LINK_STATS_ENABLE
@@ -8,3 +8,7 @@
 #        define F_SCL 100000UL // SCL frequency
 #    endif
 #endif
+
+#if defined(SPLIT_LINK_STATS_ENABLE) && !defined(SPLIT_COMMON_TRANSACTIONS)
+#    error "SPLIT_LINK_STATS_ENABLE requires the QMK-provided split transport"
+#endif
@@ -0,0 +1,10 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#define MATRIX_ROWS 4
+#define MATRIX_COLS 10
+
+#define SPLIT_KEYBOARD
+#define DISABLE_SYNC_TIMER
+#define FORCED_SYNC_THROTTLE_MS 100
@@ -0,0 +1,159 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "mock_transport.h"
+
+bool     mock_link_up      = true;
+bool     mock_link_corrupt = false;
+int8_t   mock_link_lose    = -1;
+uint16_t mock_transactions[NUM_TOTAL_TRANSACTIONS];
+
+static split_shared_memory_t master_memory;
+static split_shared_memory_t slave_memory;
+static split_shared_memory_t saved_memory;
+matrix_row_t                 mock_slave_master_matrix[MATRIX_ROWS / 2];
+
+split_shared_memory_t *const split_shmem = &master_memory;
+
+// Both halves share split_shmem here, so the slave's copy is swapped in while it runs
+static void enter_slave(void) {
+    memcpy(&saved_memory, &master_memory, sizeof(master_memory));
+    memcpy(&master_memory, &slave_memory, sizeof(slave_memory));
+}
+
+static void leave_slave(void) {
+    memcpy(&slave_memory, &master_memory, sizeof(master_memory));
+    memcpy(&master_memory, &saved_memory, sizeof(saved_memory));
+}
+
+bool is_transport_connected(void) {
+    return mock_link_up;
+}
+
+// What happens on the wire, once the initiator buffer is in place
+static bool mock_exchange(int8_t id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+
+    if (!mock_link_up) {
+        return false;
+    }
+    mock_transactions[id]++;
+
+    if (id == mock_link_lose) {
+        mock_link_lose = -1;
+    } else if (trans->initiator2target_buffer_size > 0) {
+        memcpy((uint8_t *)&slave_memory + trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    }
+
+    if (trans->slave_callback) {
+        enter_slave();
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        leave_slave();
+    }
+
+    if (trans->target2initiator_buffer_size > 0) {
+        memcpy(split_trans_target2initiator_buffer(trans), (uint8_t *)&slave_memory + trans->target2initiator_offset, trans->target2initiator_buffer_size);
+        if (mock_link_corrupt) {
+            split_trans_target2initiator_buffer(trans)[trans->target2initiator_buffer_size - 1] ^= 1;
+        }
+    }
+
+    return true;
+}
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+static int8_t                   async_id     = -1;
+static transport_async_status_t async_status = TRANSPORT_ASYNC_IDLE;
+
+bool transport_start_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+
+    if (async_id >= 0) {
+        return false;
+    }
+
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+    async_id     = id;
+    async_status = TRANSPORT_ASYNC_BUSY;
+    return true;
+}
+
+transport_async_status_t transport_poll_transaction(void *target2initiator_buf, uint16_t target2initiator_length) {
+    if (async_id < 0) {
+        return TRANSPORT_ASYNC_IDLE;
+    }
+    if (async_status == TRANSPORT_ASYNC_BUSY) {
+        return async_status;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[async_id];
+    if (async_status == TRANSPORT_ASYNC_DONE && target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+    async_id = -1;
+    return async_status;
+}
+
+bool mock_transport_busy(void) {
+    return async_status == TRANSPORT_ASYNC_BUSY;
+}
+
+void mock_transport_complete(void) {
+    if (async_status == TRANSPORT_ASYNC_BUSY) {
+        async_status = mock_exchange(async_id) ? TRANSPORT_ASYNC_DONE : TRANSPORT_ASYNC_FAILED;
+    }
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+    // The link is only free once the transaction in the background is over
+    mock_transport_complete();
+#endif // SPLIT_TRANSPORT_ASYNC
+
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    if (!mock_exchange(id)) {
+        return false;
+    }
+
+    if (target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+
+    return true;
+}
+
+void mock_transport_reset(void) {
+    mock_link_up      = true;
+    mock_link_corrupt = false;
+    mock_link_lose    = -1;
+    memset(mock_transactions, 0, sizeof(mock_transactions));
+#ifdef SPLIT_TRANSPORT_ASYNC
+    async_id     = -1;
+    async_status = TRANSPORT_ASYNC_IDLE;
+#endif // SPLIT_TRANSPORT_ASYNC
+}
+
+void mock_slave_reboot(void) {
+    memset(&slave_memory, 0, sizeof(slave_memory));
+    memset(mock_slave_master_matrix, 0, sizeof(mock_slave_master_matrix));
+}
+
+void mock_slave_task(matrix_row_t slave_matrix[]) {
+    enter_slave();
+    transactions_slave(mock_slave_master_matrix, slave_matrix);
+    leave_slave();
+}
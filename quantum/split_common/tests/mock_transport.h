@@ -0,0 +1,31 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "transactions.h"
+
+// Simulated link between the master and a slave half living in the same process
+extern bool     mock_link_up;
+extern bool     mock_link_corrupt; // flips a bit of every reply while set
+extern int8_t   mock_link_lose;    // loses what the master sends with the next transaction of this ID, unnoticed by either side
+extern uint16_t mock_transactions[NUM_TOTAL_TRANSACTIONS];
+
+// What the slave received of the master matrix, with SPLIT_TRANSPORT_MIRROR
+extern matrix_row_t mock_slave_master_matrix[MATRIX_ROWS / 2];
+
+void mock_transport_reset(void);
+void mock_slave_reboot(void);
+void mock_slave_task(matrix_row_t slave_matrix[]);
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+// Transactions started with transport_start_transaction() stay on the wire until completed here
+bool mock_transport_busy(void);
+void mock_transport_complete(void);
+#endif
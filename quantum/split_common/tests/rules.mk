@@ -0,0 +1,85 @@
+split_transactions_DEFS := -DNO_DEBUG
+split_transactions_INC := $(QUANTUM_PATH)/split_common
+split_transactions_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_mock.h
+
+split_transactions_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/tests/mock_transport.c \
+	$(QUANTUM_PATH)/split_common/tests/split_matrix_tests.cpp
+
+split_matrix_delta_sync_DEFS := $(split_transactions_DEFS) -DSPLIT_MATRIX_DELTA_SYNC
+split_matrix_delta_sync_INC := $(split_transactions_INC)
+split_matrix_delta_sync_CONFIG := $(split_transactions_CONFIG)
+split_matrix_delta_sync_SRC := $(split_transactions_SRC)
+
+split_transaction_batching_DEFS := $(split_transactions_DEFS) \
+	-DSPLIT_TRANSACTION_BATCHING \
+	-DSPLIT_BATCH_FRAME_SIZE=7 \
+	-DSPLIT_TRANSPORT_MIRROR \
+	-DSPLIT_LED_STATE_ENABLE \
+	-DSPLIT_MODS_ENABLE \
+	-DNO_ACTION_ONESHOT
+split_transaction_batching_INC := $(split_transactions_INC)
+split_transaction_batching_CONFIG := $(split_transactions_CONFIG)
+split_transaction_batching_SRC := \
+	$(split_transactions_SRC) \
+	$(QUANTUM_PATH)/split_common/tests/split_batching_tests.cpp
+
+split_transport_async_DEFS := $(split_transactions_DEFS) \
+	-DSPLIT_TRANSACTION_BATCHING \
+	-DSPLIT_TRANSPORT_ASYNC \
+	-DSPLIT_TRANSPORT_MIRROR
+split_transport_async_INC := $(split_transactions_INC)
+split_transport_async_CONFIG := $(split_transactions_CONFIG)
+split_transport_async_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/tests/mock_transport.c \
+	$(QUANTUM_PATH)/split_common/tests/split_async_tests.cpp
+
+split_sync_scheduler_DEFS := $(split_transactions_DEFS) \
+	-DSPLIT_SYNC_SCHEDULER \
+	-DSPLIT_COSMETIC_SYNC_INTERVAL=20 \
+	-DSPLIT_MODS_ENABLE \
+	-DNO_ACTION_ONESHOT \
+	-DWPM_ENABLE \
+	-DSPLIT_WPM_ENABLE \
+	-DOLED_ENABLE \
+	-DSPLIT_OLED_ENABLE
+split_sync_scheduler_INC := $(split_transactions_INC) $(DRIVER_PATH)/oled
+split_sync_scheduler_CONFIG := $(split_transactions_CONFIG)
+split_sync_scheduler_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/tests/mock_transport.c \
+	$(QUANTUM_PATH)/split_common/tests/split_scheduler_tests.cpp
+
+split_link_stats_DEFS := $(split_transactions_DEFS) -DSPLIT_LINK_STATS_ENABLE
+split_link_stats_INC := $(split_transactions_INC)
+split_link_stats_CONFIG := $(split_transactions_CONFIG)
+split_link_stats_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/link_stats.c \
+	$(QUANTUM_PATH)/split_common/tests/mock_transport.c \
+	$(QUANTUM_PATH)/split_common/tests/split_link_stats_tests.cpp
+
+split_rpc_stream_DEFS := $(split_transactions_DEFS) \
+	-DSPLIT_TRANSACTION_IDS_USER=USER_STREAM \
+	-DSPLIT_RPC_STREAM_ENABLE \
+	-DSPLIT_RPC_STREAM_CHUNK_SIZE=8 \
+	-DSPLIT_RPC_STREAM_WINDOW=3 \
+	-DSPLIT_RPC_STREAM_RETRIES=3
+split_rpc_stream_INC := $(split_transactions_INC)
+split_rpc_stream_CONFIG := $(split_transactions_CONFIG)
+split_rpc_stream_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/tests/mock_transport.c \
+	$(QUANTUM_PATH)/split_common/tests/split_rpc_stream_tests.cpp
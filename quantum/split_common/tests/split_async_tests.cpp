@@ -0,0 +1,83 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_test_fixture.hpp"
+
+class SplitAsync : public SplitTestFixture {};
+
+TEST_F(SplitAsync, ScanDoesNotWaitForTheLink) {
+    slave_matrix[0] = 0b1;
+    for (int i = 0; i < 10; i++) {
+        EXPECT_TRUE(sync());
+    }
+    EXPECT_TRUE(mock_transport_busy());
+    EXPECT_EQ(total_transactions(), 0);
+    EXPECT_EQ(received[0], 0);
+}
+
+TEST_F(SplitAsync, MasterUsesLastCompletedReply) {
+    slave_matrix[1] = 0b110;
+    EXPECT_TRUE(sync());
+    mock_transport_complete();
+    EXPECT_EQ(received[1], 0);
+
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(received[1], 0b110);
+    EXPECT_EQ(mock_transactions[GET_BATCH_REPLY], 1);
+    EXPECT_EQ(total_transactions(), 1);
+
+    // Still in progress, the last reply stands
+    slave_matrix[1] = 0;
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(received[1], 0b110);
+}
+
+TEST_F(SplitAsync, FailedExchangeIsReported) {
+    EXPECT_TRUE(sync());
+    mock_link_up = false;
+    mock_transport_complete();
+    EXPECT_FALSE(sync());
+
+    mock_link_up    = true;
+    slave_matrix[0] = 0b1000;
+    mock_slave_task(slave_matrix);
+    mock_transport_complete();
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(received[0], 0b1000);
+}
+
+TEST_F(SplitAsync, CorruptedReplyIsReported) {
+    slave_matrix[0] = 0b1;
+    EXPECT_TRUE(sync());
+    mock_transport_complete();
+    EXPECT_TRUE(sync());
+
+    slave_matrix[0]   = 0b10;
+    mock_link_corrupt = true;
+    mock_slave_task(slave_matrix);
+    mock_transport_complete();
+    EXPECT_FALSE(sync());
+    EXPECT_EQ(received[0], 0b1);
+}
+
+TEST_F(SplitAsync, FrameGoesOutWithTheNextExchange) {
+    master_matrix[0] = 0b11;
+    // Queued while the reply is being fetched
+    EXPECT_TRUE(sync());
+    mock_transport_complete();
+    EXPECT_EQ(mock_transactions[EXCHANGE_BATCH], 0);
+
+    // Sent
+    EXPECT_TRUE(sync());
+    mock_transport_complete();
+    EXPECT_EQ(mock_transactions[EXCHANGE_BATCH], 1);
+
+    // Applied by the slave, and not sent again once acknowledged
+    mock_slave_task(slave_matrix);
+    EXPECT_EQ(mock_slave_master_matrix[0], 0b11);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(sync());
+        mock_transport_complete();
+    }
+    EXPECT_EQ(mock_transactions[EXCHANGE_BATCH], 1);
+}
@@ -0,0 +1,141 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_test_fixture.hpp"
+
+extern "C" {
+uint8_t master_leds;
+uint8_t slave_leds;
+uint8_t master_mods;
+uint8_t slave_mods;
+
+uint8_t host_keyboard_leds(void) {
+    return master_leds;
+}
+
+void set_split_host_keyboard_leds(uint8_t led_state) {
+    slave_leds = led_state;
+}
+
+uint8_t get_mods(void) {
+    return master_mods;
+}
+
+uint8_t get_weak_mods(void) {
+    return 0;
+}
+
+void set_mods(uint8_t mods) {
+    slave_mods = mods;
+}
+
+void set_weak_mods(uint8_t mods) {}
+}
+
+class SplitBatching : public SplitTestFixture {
+   protected:
+    void SetUp() override {
+        master_leds = 0;
+        slave_leds  = 0;
+        master_mods = 0;
+        slave_mods  = 0;
+        SplitTestFixture::SetUp();
+    }
+};
+
+TEST_F(SplitBatching, IdleScanOnlyReadsTheReply) {
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(mock_transactions[GET_BATCH_REPLY], 1);
+    EXPECT_EQ(total_transactions(), 1);
+}
+
+TEST_F(SplitBatching, SlaveKeyReachesMasterInOneExchange) {
+    slave_matrix[1] = 0b1010;
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(received[1], 0b1010);
+    EXPECT_EQ(total_transactions(), 1);
+}
+
+TEST_F(SplitBatching, ChangesAreSentInOneFrame) {
+    master_matrix[0] = 0b11;
+    master_leds      = 0b10;
+
+    // Queued
+    EXPECT_TRUE(sync());
+    // Sent
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(mock_transactions[EXCHANGE_BATCH], 1);
+    EXPECT_EQ(total_transactions(), 2);
+    // Applied by the slave
+    mock_slave_task(slave_matrix);
+    EXPECT_EQ(mock_slave_master_matrix[0], 0b11);
+    EXPECT_EQ(slave_leds, 0b10);
+}
+
+TEST_F(SplitBatching, AppliedFrameIsNotSentAgain) {
+    master_leds = 0b1;
+    for (int i = 0; i < 5; i++) {
+        EXPECT_TRUE(sync());
+    }
+    EXPECT_EQ(slave_leds, 0b1);
+    EXPECT_EQ(mock_transactions[EXCHANGE_BATCH], 1);
+
+    // Acknowledged, so only the reply is read
+    mock_transport_reset();
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(sync());
+    }
+    EXPECT_EQ(mock_transactions[EXCHANGE_BATCH], 0);
+    EXPECT_EQ(mock_transactions[GET_BATCH_REPLY], 3);
+    EXPECT_EQ(total_transactions(), 3);
+}
+
+TEST_F(SplitBatching, FailedFrameIsSentAgain) {
+    master_leds = 0b100;
+    EXPECT_TRUE(sync());
+
+    mock_link_up = false;
+    EXPECT_FALSE(sync());
+    EXPECT_EQ(mock_transactions[EXCHANGE_BATCH], 0);
+
+    mock_link_up = true;
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(mock_transactions[EXCHANGE_BATCH], 1);
+    mock_slave_task(slave_matrix);
+    EXPECT_EQ(slave_leds, 0b100);
+}
+
+TEST_F(SplitBatching, UnacknowledgedFrameIsSentAgain) {
+    master_leds = 0b1000;
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(mock_transactions[EXCHANGE_BATCH], 1);
+
+    // The slave didn't get to apply it
+    mock_link_corrupt = true;
+    EXPECT_FALSE(transactions_master(master_matrix, received));
+    mock_link_corrupt = false;
+    EXPECT_TRUE(transactions_master(master_matrix, received));
+    EXPECT_GE(mock_transactions[EXCHANGE_BATCH], 2);
+
+    mock_slave_task(slave_matrix);
+    EXPECT_EQ(slave_leds, 0b1000);
+}
+
+TEST_F(SplitBatching, WhatDoesntFitGoesInTheNextFrame) {
+    master_matrix[1] = 0b1;
+    master_leds      = 0b11;
+    master_mods      = 0x02;
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+    mock_slave_task(slave_matrix);
+    EXPECT_EQ(mock_slave_master_matrix[1], 0b1);
+    EXPECT_EQ(slave_leds, 0b11);
+    EXPECT_EQ(slave_mods, 0);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(sync());
+    }
+    EXPECT_EQ(slave_mods, 0x02);
+    EXPECT_EQ(mock_transactions[EXCHANGE_BATCH], 2);
+}
@@ -0,0 +1,95 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_test_fixture.hpp"
+
+extern "C" {
+#include "link_stats.h"
+}
+
+class SplitLinkStats : public SplitTestFixture {
+   protected:
+    void SetUp() override {
+        SplitTestFixture::SetUp();
+        split_link_stats_reset();
+    }
+
+    uint32_t read_u32(const uint8_t *data) {
+        return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+    }
+};
+
+TEST_F(SplitLinkStats, CompletedTransactionsAreCounted) {
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+
+    split_link_stats_t stats;
+    split_link_stats_get(GET_SLAVE_MATRIX_CHECKSUM, &stats);
+    EXPECT_EQ(stats.success, mock_transactions[GET_SLAVE_MATRIX_CHECKSUM]);
+    EXPECT_EQ(stats.bytes, stats.success * split_transaction_table[GET_SLAVE_MATRIX_CHECKSUM].target2initiator_buffer_size);
+    EXPECT_EQ(stats.timeout, 0);
+    EXPECT_EQ(stats.checksum_error, 0);
+}
+
+TEST_F(SplitLinkStats, FailuresAreCountedAsTimeouts) {
+    mock_link_up = false;
+    EXPECT_FALSE(sync());
+
+    split_link_stats_t stats;
+    split_link_stats_get(GET_SLAVE_MATRIX_CHECKSUM, &stats);
+    EXPECT_GT(stats.timeout, 0);
+    EXPECT_EQ(stats.success, 0);
+    EXPECT_EQ(stats.bytes, 0);
+}
+
+TEST_F(SplitLinkStats, CorruptedRepliesAreCountedAsChecksumErrors) {
+    slave_matrix[0]   = 0b1;
+    mock_link_corrupt = true;
+    EXPECT_FALSE(sync());
+
+    split_link_stats_t stats;
+    split_link_stats_get(GET_SLAVE_MATRIX_DATA, &stats);
+    EXPECT_GT(stats.checksum_error, 0);
+    EXPECT_EQ(stats.checksum_error, stats.success);
+}
+
+TEST_F(SplitLinkStats, TotalsCoverAllTransactions) {
+    slave_matrix[1] = 0b10;
+    EXPECT_TRUE(sync());
+
+    split_link_stats_t total;
+    split_link_stats_get(-1, &total);
+    uint32_t expected = 0;
+    for (int id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        expected += mock_transactions[id];
+    }
+    EXPECT_EQ(total.success, expected);
+
+    split_link_stats_reset();
+    split_link_stats_get(-1, &total);
+    EXPECT_EQ(total.success, 0);
+}
+
+TEST_F(SplitLinkStats, RawHidReportsCounters) {
+    mock_link_up = false;
+    EXPECT_FALSE(sync());
+    mock_link_up = true;
+    EXPECT_TRUE(sync());
+
+    uint8_t data[32] = {SPLIT_LINK_STATS_RAW_HID_ID, 0x02, GET_SLAVE_MATRIX_CHECKSUM};
+    EXPECT_TRUE(split_link_stats_raw_hid_receive(data, sizeof(data)));
+    EXPECT_EQ(data[1], 0x02);
+    EXPECT_EQ(read_u32(&data[3]), 1);
+    EXPECT_EQ(read_u32(&data[7]), 1);
+
+    uint8_t clear[32] = {SPLIT_LINK_STATS_RAW_HID_ID, 0x03};
+    EXPECT_TRUE(split_link_stats_raw_hid_receive(clear, sizeof(clear)));
+
+    uint8_t after[32] = {SPLIT_LINK_STATS_RAW_HID_ID, 0x02, 0xFF};
+    EXPECT_TRUE(split_link_stats_raw_hid_receive(after, sizeof(after)));
+    EXPECT_EQ(read_u32(&after[3]), 0);
+    EXPECT_EQ(read_u32(&after[7]), 0);
+
+    uint8_t other[32] = {0x01};
+    EXPECT_FALSE(split_link_stats_raw_hid_receive(other, sizeof(other)));
+}
@@ -0,0 +1,133 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_test_fixture.hpp"
+
+extern "C" {
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+class SplitMatrix : public SplitTestFixture {
+   protected:
+    void expect_in_sync() {
+        for (int row = 0; row < SLAVE_ROWS; row++) {
+            EXPECT_EQ(received[row], slave_matrix[row]) << "row " << row;
+        }
+    }
+};
+
+TEST_F(SplitMatrix, KeyPressAndReleaseReachMaster) {
+    slave_matrix[1] |= 1 << 7;
+    EXPECT_TRUE(sync());
+    expect_in_sync();
+
+    slave_matrix[1] &= ~(1 << 7);
+    EXPECT_TRUE(sync());
+    expect_in_sync();
+}
+
+TEST_F(SplitMatrix, CorruptedReplyKeepsLastKnownMatrix) {
+    slave_matrix[0] = 0b101;
+    EXPECT_TRUE(sync());
+
+    slave_matrix[0] = 0b100;
+    mock_link_corrupt = true;
+    EXPECT_FALSE(sync());
+    EXPECT_EQ(received[0], 0b101);
+
+    mock_link_corrupt = false;
+    EXPECT_TRUE(sync());
+    expect_in_sync();
+}
+
+#ifdef SPLIT_MATRIX_DELTA_SYNC
+
+TEST_F(SplitMatrix, KeyChangeTakesOneTransaction) {
+    slave_matrix[0] |= 1 << 2;
+    EXPECT_TRUE(sync());
+    expect_in_sync();
+    EXPECT_EQ(mock_transactions[GET_SLAVE_MATRIX_EVENTS], 1);
+    EXPECT_EQ(mock_transactions[GET_SLAVE_MATRIX_DATA], 0);
+}
+
+TEST_F(SplitMatrix, IdleScansDontReadMatrix) {
+    for (int i = 0; i < 10; i++) {
+        advance_time(FORCED_SYNC_THROTTLE_MS);
+        EXPECT_TRUE(sync());
+    }
+    EXPECT_EQ(mock_transactions[GET_SLAVE_MATRIX_EVENTS], 10);
+    EXPECT_EQ(mock_transactions[GET_SLAVE_MATRIX_DATA], 0);
+}
+
+TEST_F(SplitMatrix, QueuedChangesAreAppliedInOrder) {
+    // Pressed and released before the master gets to see it
+    slave_matrix[0] |= 1 << 4;
+    mock_slave_task(slave_matrix);
+    slave_matrix[0] &= ~(1 << 4);
+    slave_matrix[1] |= 1 << 9;
+    EXPECT_TRUE(sync());
+    expect_in_sync();
+    EXPECT_EQ(mock_transactions[GET_SLAVE_MATRIX_DATA], 0);
+}
+
+TEST_F(SplitMatrix, QueueOverflowResyncsWholeMatrix) {
+    for (int col = 0; col <= SPLIT_MATRIX_EVENT_QUEUE_SIZE; col++) {
+        slave_matrix[col % SLAVE_ROWS] |= 1 << col;
+        mock_slave_task(slave_matrix);
+    }
+    EXPECT_TRUE(sync());
+    expect_in_sync();
+    EXPECT_EQ(mock_transactions[GET_SLAVE_MATRIX_EVENTS], 1);
+    EXPECT_EQ(mock_transactions[GET_SLAVE_MATRIX_DATA], 1);
+
+    mock_transport_reset();
+    slave_matrix[0] = 0;
+    EXPECT_TRUE(sync());
+    expect_in_sync();
+    EXPECT_EQ(mock_transactions[GET_SLAVE_MATRIX_DATA], 0);
+}
+
+TEST_F(SplitMatrix, SlaveRebootResyncsWholeMatrix) {
+    for (int i = 0; i < 5; i++) {
+        slave_matrix[0] ^= 1;
+        EXPECT_TRUE(sync());
+    }
+
+    mock_slave_reboot();
+    slave_matrix[1] = 0b11;
+    EXPECT_TRUE(sync());
+    expect_in_sync();
+    EXPECT_EQ(mock_transactions[GET_SLAVE_MATRIX_DATA], 1);
+}
+
+TEST_F(SplitMatrix, FailedReadDoesntResyncWholeMatrix) {
+    slave_matrix[0] |= 1 << 3;
+    mock_link_corrupt = true;
+    EXPECT_FALSE(sync());
+
+    mock_link_corrupt = false;
+    EXPECT_TRUE(sync());
+    expect_in_sync();
+    EXPECT_EQ(mock_transactions[GET_SLAVE_MATRIX_DATA], 0);
+}
+
+TEST_F(SplitMatrix, SlaveRebootWithinQueueSizeResyncsWholeMatrix) {
+    // 255 changes, leaving the key pressed
+    for (int i = 0; i < 255; i++) {
+        slave_matrix[0] ^= 1 << 3;
+        EXPECT_TRUE(sync());
+    }
+    mock_transport_reset();
+
+    // The slave restarts at sequence 0, which looks like only two changes
+    // to the master, one of them coming from the zeroed queue
+    mock_slave_reboot();
+    slave_matrix[0] = 1 << 5;
+    EXPECT_TRUE(sync());
+    expect_in_sync();
+    EXPECT_EQ(mock_transactions[GET_SLAVE_MATRIX_DATA], 1);
+}
+
+#endif // SPLIT_MATRIX_DELTA_SYNC
@@ -0,0 +1,185 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_test_fixture.hpp"
+
+#define PAYLOAD_SIZE 100
+
+namespace {
+int      sent_calls;
+bool     sent_success;
+int      received_calls;
+uint16_t received_length;
+
+void stream_sent(int8_t transaction_id, bool success) {
+    EXPECT_EQ(transaction_id, USER_STREAM);
+    sent_calls++;
+    sent_success = success;
+}
+
+void stream_received(int8_t transaction_id, uint16_t length, void *buffer) {
+    EXPECT_EQ(transaction_id, USER_STREAM);
+    received_calls++;
+    received_length = length;
+}
+} // namespace
+
+class SplitRpcStream : public SplitTestFixture {
+   protected:
+    uint8_t payload[PAYLOAD_SIZE];
+    uint8_t buffer[PAYLOAD_SIZE];
+
+    void SetUp() override {
+        SplitTestFixture::SetUp();
+        sent_calls      = 0;
+        sent_success    = false;
+        received_calls  = 0;
+        received_length = 0;
+
+        for (int i = 0; i < PAYLOAD_SIZE; i++) {
+            payload[i] = i * 7 + 3;
+        }
+        memset(buffer, 0, sizeof(buffer));
+        transaction_register_rpc_stream(USER_STREAM, buffer, sizeof(buffer), stream_received);
+    }
+
+    // Runs scans until both halves are done with the stream
+    int sync_until_done(int max_scans = 100) {
+        int scans = 0;
+        while (scans < max_scans && (transaction_rpc_stream_busy() || (sent_success && received_calls == 0))) {
+            sync();
+            scans++;
+        }
+        mock_slave_task(slave_matrix);
+        return scans;
+    }
+};
+
+TEST_F(SplitRpcStream, PayloadLargerThanTheRpcBuffersArrives) {
+    ASSERT_GT(PAYLOAD_SIZE, RPC_M2S_BUFFER_SIZE);
+    EXPECT_TRUE(transaction_rpc_stream(USER_STREAM, PAYLOAD_SIZE, payload, stream_sent));
+    EXPECT_TRUE(transaction_rpc_stream_busy());
+
+    sync_until_done();
+
+    EXPECT_EQ(sent_calls, 1);
+    EXPECT_TRUE(sent_success);
+    EXPECT_EQ(received_calls, 1);
+    EXPECT_EQ(received_length, PAYLOAD_SIZE);
+    EXPECT_EQ(memcmp(buffer, payload, PAYLOAD_SIZE), 0);
+    EXPECT_EQ(mock_transactions[PUT_RPC_STREAM_CHUNK], (PAYLOAD_SIZE + SPLIT_RPC_STREAM_CHUNK_SIZE - 1) / SPLIT_RPC_STREAM_CHUNK_SIZE);
+    EXPECT_EQ(mock_transactions[PUT_RPC_INFO], 0);
+}
+
+TEST_F(SplitRpcStream, ChunksAreSentAWindowAtATime) {
+    EXPECT_TRUE(transaction_rpc_stream(USER_STREAM, PAYLOAD_SIZE, payload, stream_sent));
+
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(mock_transactions[PUT_RPC_STREAM_CHUNK], SPLIT_RPC_STREAM_WINDOW);
+    EXPECT_TRUE(sync());
+    EXPECT_EQ(mock_transactions[PUT_RPC_STREAM_CHUNK], 2 * SPLIT_RPC_STREAM_WINDOW);
+    EXPECT_EQ(sent_calls, 0);
+
+    sync_until_done();
+    EXPECT_TRUE(sent_success);
+}
+
+TEST_F(SplitRpcStream, LostChunksAreSentAgain) {
+    EXPECT_TRUE(transaction_rpc_stream(USER_STREAM, PAYLOAD_SIZE, payload, stream_sent));
+    EXPECT_TRUE(sync());
+
+    mock_link_lose = PUT_RPC_STREAM_CHUNK;
+    sync_until_done();
+
+    EXPECT_TRUE(sent_success);
+    EXPECT_EQ(received_calls, 1);
+    EXPECT_EQ(memcmp(buffer, payload, PAYLOAD_SIZE), 0);
+    EXPECT_GT(mock_transactions[PUT_RPC_STREAM_CHUNK], (PAYLOAD_SIZE + SPLIT_RPC_STREAM_CHUNK_SIZE - 1) / SPLIT_RPC_STREAM_CHUNK_SIZE);
+}
+
+TEST_F(SplitRpcStream, StreamStartsOverWhenTheSlaveRestarts) {
+    EXPECT_TRUE(transaction_rpc_stream(USER_STREAM, PAYLOAD_SIZE, payload, stream_sent));
+    EXPECT_TRUE(sync());
+    EXPECT_TRUE(sync());
+
+    mock_slave_reboot();
+    memset(buffer, 0, sizeof(buffer));
+    sync_until_done();
+
+    EXPECT_TRUE(sent_success);
+    EXPECT_EQ(received_calls, 1);
+    EXPECT_EQ(memcmp(buffer, payload, PAYLOAD_SIZE), 0);
+}
+
+TEST_F(SplitRpcStream, ConsecutiveStreamsAreDeliveredSeparately) {
+    EXPECT_TRUE(transaction_rpc_stream(USER_STREAM, PAYLOAD_SIZE, payload, stream_sent));
+    sync_until_done();
+    EXPECT_FALSE(transaction_rpc_stream_busy());
+
+    payload[0] ^= 0xFF;
+    sent_success = false;
+    EXPECT_TRUE(transaction_rpc_stream(USER_STREAM, 10, payload, stream_sent));
+    sync_until_done();
+
+    EXPECT_EQ(sent_calls, 2);
+    EXPECT_EQ(received_calls, 2);
+    EXPECT_EQ(received_length, 10);
+    EXPECT_EQ(buffer[0], payload[0]);
+}
+
+TEST_F(SplitRpcStream, OneStreamAtATime) {
+    EXPECT_TRUE(transaction_rpc_stream(USER_STREAM, PAYLOAD_SIZE, payload, stream_sent));
+    EXPECT_FALSE(transaction_rpc_stream(USER_STREAM, PAYLOAD_SIZE, payload, stream_sent));
+
+    sync_until_done();
+    EXPECT_EQ(sent_calls, 1);
+}
+
+TEST_F(SplitRpcStream, StreamsThatDontFitAreRejected) {
+    transaction_register_rpc_stream(USER_STREAM, buffer, PAYLOAD_SIZE / 2, stream_received);
+    EXPECT_TRUE(transaction_rpc_stream(USER_STREAM, PAYLOAD_SIZE, payload, stream_sent));
+    sync_until_done();
+
+    EXPECT_EQ(sent_calls, 1);
+    EXPECT_FALSE(sent_success);
+    EXPECT_EQ(received_calls, 0);
+}
+
+TEST_F(SplitRpcStream, StreamResumesAfterTheLinkWasDown) {
+    EXPECT_TRUE(transaction_rpc_stream(USER_STREAM, PAYLOAD_SIZE, payload, stream_sent));
+    EXPECT_TRUE(sync());
+
+    mock_link_up = false;
+    for (int i = 0; i < 2 * SPLIT_RPC_STREAM_RETRIES; i++) {
+        EXPECT_FALSE(sync());
+    }
+    EXPECT_TRUE(transaction_rpc_stream_busy());
+
+    mock_link_up = true;
+    sync_until_done();
+
+    EXPECT_TRUE(sent_success);
+    EXPECT_EQ(received_calls, 1);
+    EXPECT_EQ(memcmp(buffer, payload, PAYLOAD_SIZE), 0);
+}
+
+TEST_F(SplitRpcStream, GivesUpWhenTheSlaveDoesntTakeTheStream) {
+    // Without the slave's scan, the first stream is never handed over and the second one is turned away
+    mock_slave_task(slave_matrix);
+    EXPECT_TRUE(transaction_rpc_stream(USER_STREAM, 10, payload, stream_sent));
+    EXPECT_TRUE(transactions_master(master_matrix, received));
+    EXPECT_TRUE(sent_success);
+
+    EXPECT_TRUE(transaction_rpc_stream(USER_STREAM, 10, payload, stream_sent));
+    for (int i = 0; i < SPLIT_RPC_STREAM_RETRIES; i++) {
+        EXPECT_TRUE(transaction_rpc_stream_busy());
+        EXPECT_TRUE(transactions_master(master_matrix, received));
+    }
+
+    EXPECT_EQ(sent_calls, 2);
+    EXPECT_FALSE(sent_success);
+    EXPECT_FALSE(transaction_rpc_stream_busy());
+
+    mock_slave_task(slave_matrix);
+    EXPECT_EQ(received_calls, 1);
+}
@@ -0,0 +1,169 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_test_fixture.hpp"
+
+extern "C" {
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+
+uint8_t master_wpm;
+uint8_t slave_wpm;
+bool    master_oled;
+bool    slave_oled;
+uint8_t master_mods;
+uint8_t slave_mods;
+
+uint8_t get_current_wpm(void) {
+    return master_wpm;
+}
+
+void set_current_wpm(uint8_t wpm) {
+    slave_wpm = wpm;
+}
+
+bool is_oled_on(void) {
+    return master_oled;
+}
+
+bool oled_on(void) {
+    return slave_oled = true;
+}
+
+bool oled_off(void) {
+    return slave_oled = false;
+}
+
+uint8_t get_mods(void) {
+    return master_mods;
+}
+
+uint8_t get_weak_mods(void) {
+    return 0;
+}
+
+void set_mods(uint8_t mods) {
+    slave_mods = mods;
+}
+
+void set_weak_mods(uint8_t mods) {}
+}
+
+class SplitScheduler : public SplitTestFixture {
+   protected:
+    void SetUp() override {
+        master_wpm  = 0;
+        master_oled = false;
+        master_mods = 0;
+        split_sync_set_interval(PUT_WPM, SPLIT_COSMETIC_SYNC_INTERVAL);
+        SplitTestFixture::SetUp();
+        // Rate limited state only goes out once its interval is over
+        for (int i = 0; i < 4; i++) {
+            scan();
+        }
+        mock_transport_reset();
+        split_sync_reset_stats();
+    }
+
+    bool scan() {
+        advance_time(SPLIT_COSMETIC_SYNC_INTERVAL);
+        return sync();
+    }
+
+    bool scan_for(uint32_t ms) {
+        bool okay = sync();
+        advance_time(ms);
+        return okay;
+    }
+};
+
+TEST_F(SplitScheduler, CriticalStateGoesEveryScan) {
+    for (int i = 0; i < 10; i++) {
+        master_mods = i + 1;
+        master_wpm  = i + 1;
+        EXPECT_TRUE(scan_for(1));
+        EXPECT_EQ(slave_mods, i) << "scan " << i;
+    }
+    EXPECT_EQ(mock_transactions[PUT_MODS], 10);
+    // The first one goes out straight away, the next once the interval is over
+    EXPECT_EQ(mock_transactions[PUT_WPM], 1);
+}
+
+TEST_F(SplitScheduler, CosmeticStateIsRateLimited) {
+    for (int i = 0; i < 100; i++) {
+        master_wpm = i;
+        EXPECT_TRUE(scan_for(1));
+    }
+    EXPECT_EQ(mock_transactions[PUT_WPM], 100 / SPLIT_COSMETIC_SYNC_INTERVAL);
+
+    // The last value still gets there
+    for (int i = 0; i < SPLIT_COSMETIC_SYNC_INTERVAL; i++) {
+        EXPECT_TRUE(scan_for(1));
+    }
+    mock_slave_task(slave_matrix);
+    EXPECT_EQ(slave_wpm, 99);
+}
+
+TEST_F(SplitScheduler, CosmeticStateIsSpreadAcrossScans) {
+    master_wpm  = 42;
+    master_oled = true;
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(mock_transactions[PUT_WPM] + mock_transactions[PUT_OLED], 1);
+
+    EXPECT_TRUE(scan_for(1));
+    EXPECT_EQ(mock_transactions[PUT_WPM], 1);
+    EXPECT_EQ(mock_transactions[PUT_OLED], 1);
+
+    mock_slave_task(slave_matrix);
+    EXPECT_EQ(slave_wpm, 42);
+    EXPECT_TRUE(slave_oled);
+}
+
+TEST_F(SplitScheduler, IntervalCanBeChanged) {
+    split_sync_set_interval(PUT_WPM, 0);
+    EXPECT_EQ(split_sync_get_interval(PUT_WPM), 0);
+    for (int i = 0; i < 10; i++) {
+        master_wpm = i + 1;
+        EXPECT_TRUE(scan_for(1));
+    }
+    EXPECT_EQ(mock_transactions[PUT_WPM], 10);
+}
+
+TEST_F(SplitScheduler, LinkUtilizationIsCounted) {
+    master_wpm  = 7;
+    master_oled = true;
+    master_mods = 1;
+    EXPECT_TRUE(scan());
+
+    int total = 0;
+    for (int id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        total += mock_transactions[id];
+    }
+
+    split_sync_stats_t stats;
+    split_sync_get_stats(&stats);
+    EXPECT_EQ(stats.scans, 1);
+    EXPECT_EQ(stats.transactions, total);
+    EXPECT_EQ(stats.max_per_scan, total);
+    // One of the two cosmetic transactions waits for the next scan
+    EXPECT_EQ(stats.cosmetic, 1);
+    EXPECT_EQ(stats.deferred, 1);
+    EXPECT_GT(stats.bytes, 0);
+
+    split_sync_reset_stats();
+    split_sync_get_stats(&stats);
+    EXPECT_EQ(stats.transactions, 0);
+}
+
+TEST_F(SplitScheduler, UnchangedCosmeticStateIsNotDeferred) {
+    // Uses up the budget, while the OLED has nothing to send
+    master_wpm = 9;
+    EXPECT_TRUE(scan());
+
+    split_sync_stats_t stats;
+    split_sync_get_stats(&stats);
+    EXPECT_EQ(stats.cosmetic, 1);
+    EXPECT_EQ(stats.deferred, 0);
+}
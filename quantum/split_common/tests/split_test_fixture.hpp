@@ -0,0 +1,46 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "mock_transport.h"
+}
+
+#define SLAVE_ROWS (MATRIX_ROWS / 2)
+
+// A master and a slave half connected through mock_transport
+class SplitTestFixture : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[SLAVE_ROWS] = {0};
+    matrix_row_t slave_matrix[SLAVE_ROWS]  = {0};
+    matrix_row_t received[SLAVE_ROWS]      = {0}; // the slave matrix as seen by the master
+
+    void SetUp() override {
+        mock_transport_reset();
+        mock_slave_reboot();
+        // Let anything left over from the previous test reach the slave
+        for (int i = 0; i < 4; i++) {
+            sync();
+#ifdef SPLIT_TRANSPORT_ASYNC
+            mock_transport_complete();
+#endif // SPLIT_TRANSPORT_ASYNC
+        }
+        mock_transport_reset();
+    }
+
+    // One scan of each half
+    bool sync() {
+        mock_slave_task(slave_matrix);
+        return transactions_master(master_matrix, received);
+    }
+
+    int total_transactions() {
+        int total = 0;
+        for (int id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+            total += mock_transactions[id];
+        }
+        return total;
+    }
+};
@@ -0,0 +1,8 @@
+TEST_LIST += \
+	split_transactions \
+	split_matrix_delta_sync \
+	split_transaction_batching \
+	split_transport_async \
+	split_sync_scheduler \
+	split_link_stats \
+	split_rpc_stream
@@ -21,7 +21,16 @@ enum serial_transaction_id {
     I2C_EXECUTE_CALLBACK,
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSACTION_BATCHING
+    EXCHANGE_BATCH,
+    GET_BATCH_REPLY,
+#endif // SPLIT_TRANSACTION_BATCHING
+
+#ifdef SPLIT_MATRIX_DELTA_SYNC
+    GET_SLAVE_MATRIX_EVENTS,
+#else
     GET_SLAVE_MATRIX_CHECKSUM,
+#endif // SPLIT_MATRIX_DELTA_SYNC
     GET_SLAVE_MATRIX_DATA,
 
 #ifdef SPLIT_TRANSPORT_MIRROR
@@ -97,6 +106,10 @@ enum serial_transaction_id {
 #endif // SPLIT_ACTIVITY_ENABLE
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+#    ifdef SPLIT_RPC_STREAM_ENABLE
+    PUT_RPC_STREAM_CHUNK,
+    GET_RPC_STREAM_ACK,
+#    endif // SPLIT_RPC_STREAM_ENABLE
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
     EXECUTE_RPC,
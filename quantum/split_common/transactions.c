@@ -24,11 +24,13 @@
 #include "action_util.h"
 #include "sync_timer.h"
 #include "wait.h"
+#include "util.h"
 #include "transactions.h"
 #include "transport.h"
 #include "transaction_id_define.h"
 #include "split_util.h"
 #include "synchronization_util.h"
+#include "link_stats.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -70,6 +72,32 @@
 #    define FORCED_SYNC_THROTTLE_MS 100
 #endif // FORCED_SYNC_THROTTLE_MS
 
+#ifdef SPLIT_SYNC_SCHEDULER
+#    ifndef SPLIT_COSMETIC_SYNC_INTERVAL
+#        define SPLIT_COSMETIC_SYNC_INTERVAL 50
+#    endif // SPLIT_COSMETIC_SYNC_INTERVAL
+#    ifndef SPLIT_COSMETIC_SYNC_PER_SCAN
+#        define SPLIT_COSMETIC_SYNC_PER_SCAN 1
+#    endif // SPLIT_COSMETIC_SYNC_PER_SCAN
+// clang-format off
+#    if defined(BACKLIGHT_ENABLE) || (defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)) || (defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)) || (defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)) || \
+        (defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)) || (defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)) || (defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)) || \
+        (defined(HAPTIC_ENABLE) && defined(SPLIT_HAPTIC_ENABLE)) || defined(SPLIT_ACTIVITY_ENABLE) || (defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE))
+// At least one cosmetic transaction is built in, and goes through the scheduler
+#        define SPLIT_SYNC_SCHEDULER_COSMETIC
+#    endif
+// clang-format on
+#endif // SPLIT_SYNC_SCHEDULER
+
+#ifdef SPLIT_RPC_STREAM_ENABLE
+#    ifndef SPLIT_RPC_STREAM_WINDOW
+#        define SPLIT_RPC_STREAM_WINDOW 4
+#    endif // SPLIT_RPC_STREAM_WINDOW
+#    ifndef SPLIT_RPC_STREAM_RETRIES
+#        define SPLIT_RPC_STREAM_RETRIES 10
+#    endif // SPLIT_RPC_STREAM_RETRIES
+#endif // SPLIT_RPC_STREAM_ENABLE
+
 #define sizeof_member(type, member) sizeof(((type *)NULL)->member)
 
 #define trans_initiator2target_initializer_cb(member, cb) \
@@ -80,8 +108,39 @@
     { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb }
 #define trans_target2initiator_initializer(member) trans_target2initiator_initializer_cb(member, NULL)
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+// Everything that goes over the wire on the master passes through here
+static inline bool link_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+#ifdef SPLIT_LINK_STATS_ENABLE
+    uint32_t start = timer_read_ticks();
+    bool     okay  = transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    split_link_stats_record(id, okay, timer_ticks_to_us(timer_read_ticks() - start));
+    return okay;
+#else
+    return transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+#endif // SPLIT_LINK_STATS_ENABLE
+}
+
+#ifdef SPLIT_LINK_STATS_ENABLE
+#    define link_checksum_error(id) split_link_stats_checksum_error(id)
+#else
+#    define link_checksum_error(id)
+#endif // SPLIT_LINK_STATS_ENABLE
+
+#ifdef SPLIT_TRANSACTION_BATCHING
+#    define link_write(id, data, length) batch_write(id, data, length)
+#    define link_read(id, data, length) batch_read(id, data, length)
+#else
+#    define link_write(id, data, length) link_transaction(id, data, length, NULL, 0)
+#    define link_read(id, data, length) link_transaction(id, NULL, 0, data, length)
+#endif // SPLIT_TRANSACTION_BATCHING
+
+#ifdef SPLIT_SYNC_SCHEDULER
+#    define transport_write(id, data, length) scheduled_write(id, data, length)
+#    define transport_read(id, data, length) scheduled_read(id, data, length)
+#else
+#    define transport_write(id, data, length) link_write(id, data, length)
+#    define transport_read(id, data, length) link_read(id, data, length)
+#endif // SPLIT_SYNC_SCHEDULER
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -139,12 +198,238 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
         split_shared_memory_unlock();                         \
     } while (0)
 
+#ifdef SPLIT_TRANSACTION_BATCHING
+
+static uint8_t batch_pending[(NUM_TOTAL_TRANSACTIONS + 7) / 8] = {0}; // bitmask of the transactions waiting for the next frame
+
+static inline bool batch_is_pending(int8_t id) {
+    return batch_pending[id / 8] & (1 << (id % 8));
+}
+
+static bool batch_any_pending(void) {
+    for (uint8_t i = 0; i < sizeof(batch_pending); i++) {
+        if (batch_pending[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool batch_includes_write(int8_t id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+
+#    if !defined(DISABLE_SYNC_TIMER) && !defined(SPLIT_TRANSPORT_ASYNC)
+    // Must not wait for the next scan to be accurate, unless it would have to wait for the exchange in progress anyway
+    if (id == PUT_SYNC_TIMER) return false;
+#    endif // !defined(DISABLE_SYNC_TIMER) && !defined(SPLIT_TRANSPORT_ASYNC)
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    // Must stay in order with the other RPC transactions
+    if (id == PUT_RPC_REQ_DATA) return false;
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+
+    return !trans->slave_callback && trans->target2initiator_buffer_size == 0 && trans->initiator2target_buffer_size + 1 <= SPLIT_BATCH_FRAME_SIZE;
+}
+
+static bool batch_includes_read(int8_t id) {
+    switch (id) {
+#    ifdef SPLIT_MATRIX_DELTA_SYNC
+        case GET_SLAVE_MATRIX_EVENTS:
+#    else
+        case GET_SLAVE_MATRIX_CHECKSUM:
+#    endif // SPLIT_MATRIX_DELTA_SYNC
+        case GET_SLAVE_MATRIX_DATA:
+#    ifdef ENCODER_ENABLE
+        case GET_ENCODERS_CHECKSUM:
+        case GET_ENCODERS_DATA:
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+        case GET_POINTING_CHECKSUM:
+        case GET_POINTING_DATA:
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool batch_write(int8_t id, const void *data, uint16_t length) {
+    if (!batch_includes_write(id)) {
+        return link_transaction(id, data, length, NULL, 0);
+    }
+
+    // Keep the local copy up to date, as the transport would, for the handlers comparing against it
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    memcpy(split_trans_initiator2target_buffer(trans), data, MIN(length, trans->initiator2target_buffer_size));
+    batch_pending[id / 8] |= (1 << (id % 8));
+    return true;
+}
+
+static bool batch_read(int8_t id, void *data, uint16_t length) {
+    if (!batch_includes_read(id)) {
+        return link_transaction(id, NULL, 0, data, length);
+    }
+
+    // Already received with the reply at the start of the scan
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    memcpy(data, split_trans_target2initiator_buffer(trans), MIN(length, trans->target2initiator_buffer_size));
+    return true;
+}
+
+#endif // SPLIT_TRANSACTION_BATCHING
+
+#ifdef SPLIT_SYNC_SCHEDULER
+
+// Minimum time between two transactions of the same ID, 0 for the ones sent every scan
+// clang-format off
+static uint16_t sync_interval[NUM_TOTAL_TRANSACTIONS] = {
+#    ifdef BACKLIGHT_ENABLE
+    [PUT_BACKLIGHT]   = SPLIT_COSMETIC_SYNC_INTERVAL,
+#    endif // BACKLIGHT_ENABLE
+#    if defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+    [PUT_RGBLIGHT]    = SPLIT_COSMETIC_SYNC_INTERVAL,
+#    endif // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
+#    if defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+    [PUT_LED_MATRIX]  = SPLIT_COSMETIC_SYNC_INTERVAL,
+#    endif // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
+#    if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+    [PUT_RGB_MATRIX]  = SPLIT_COSMETIC_SYNC_INTERVAL,
+#    endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#    if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
+    [PUT_WPM]         = SPLIT_COSMETIC_SYNC_INTERVAL,
+#    endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
+#    if defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
+    [PUT_OLED]        = SPLIT_COSMETIC_SYNC_INTERVAL,
+#    endif // defined(OLED_ENABLE) && defined(SPLIT_OLED_ENABLE)
+#    if defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
+    [PUT_ST7565]      = SPLIT_COSMETIC_SYNC_INTERVAL,
+#    endif // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
+#    if defined(HAPTIC_ENABLE) && defined(SPLIT_HAPTIC_ENABLE)
+    [PUT_HAPTIC]      = SPLIT_COSMETIC_SYNC_INTERVAL,
+#    endif // defined(HAPTIC_ENABLE) && defined(SPLIT_HAPTIC_ENABLE)
+#    if defined(SPLIT_ACTIVITY_ENABLE)
+    [PUT_ACTIVITY]    = SPLIT_COSMETIC_SYNC_INTERVAL,
+#    endif // defined(SPLIT_ACTIVITY_ENABLE)
+#    if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+    [PUT_DETECTED_OS] = SPLIT_COSMETIC_SYNC_INTERVAL,
+#    endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+};
+// clang-format on
+
+static uint16_t           sync_last_sent[NUM_TOTAL_TRANSACTIONS];
+static uint8_t            sync_cosmetic_budget   = 0; // cosmetic transactions left for this scan
+static uint8_t            sync_scan_transactions = 0;
+static bool               sync_deferring         = false; // running a handler only to find out if it has something to send
+static split_sync_stats_t sync_stats             = {0};
+
+void split_sync_set_interval(int8_t id, uint16_t interval_ms) {
+    if (id >= 0 && id < NUM_TOTAL_TRANSACTIONS) {
+        sync_interval[id] = interval_ms;
+    }
+}
+
+uint16_t split_sync_get_interval(int8_t id) {
+    return (id >= 0 && id < NUM_TOTAL_TRANSACTIONS) ? sync_interval[id] : 0;
+}
+
+void split_sync_get_stats(split_sync_stats_t *stats) {
+    memcpy(stats, &sync_stats, sizeof(sync_stats));
+}
+
+void split_sync_reset_stats(void) {
+    memset(&sync_stats, 0, sizeof(sync_stats));
+}
+
+static void sync_scheduler_begin_scan(void) {
+    sync_cosmetic_budget   = SPLIT_COSMETIC_SYNC_PER_SCAN;
+    sync_scan_transactions = 0;
+    sync_stats.scans++;
+}
+
+static void sync_scheduler_record(int8_t id, bool okay) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+
+    sync_stats.transactions++;
+    sync_stats.bytes += trans->initiator2target_buffer_size + trans->target2initiator_buffer_size;
+    if (++sync_scan_transactions > sync_stats.max_per_scan) {
+        sync_stats.max_per_scan = sync_scan_transactions;
+    }
+
+    if (sync_interval[id] != 0) {
+        sync_stats.cosmetic++;
+        if (sync_cosmetic_budget > 0) {
+            sync_cosmetic_budget--;
+        }
+        // Failures are retried on the next scan, not after a whole interval
+        if (okay) {
+            sync_last_sent[id] = timer_read();
+        }
+    }
+}
+
+static bool scheduled_write(int8_t id, const void *data, uint16_t length) {
+    if (sync_deferring) {
+        // Its turn comes in one of the next scans
+        sync_stats.deferred++;
+        return false;
+    }
+    bool okay = link_write(id, data, length);
+    sync_scheduler_record(id, okay);
+    return okay;
+}
+
+static bool scheduled_read(int8_t id, void *data, uint16_t length) {
+    bool okay = link_read(id, data, length);
+    sync_scheduler_record(id, okay);
+    return okay;
+}
+
+#    ifdef SPLIT_SYNC_SCHEDULER_COSMETIC
+
+// Whether the interval of a cosmetic transaction is over
+static bool sync_scheduler_due(int8_t id) {
+    return sync_interval[id] == 0 || timer_elapsed(sync_last_sent[id]) >= sync_interval[id];
+}
+
+// Runs the handler of a transaction that is due but over this scan's budget,
+// with its write counted as deferred instead of sent. Handlers with nothing
+// to write don't count.
+static void sync_scheduler_defer(bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]), matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    sync_deferring = true;
+    handler(master_matrix, slave_matrix);
+    sync_deferring = false;
+}
+
+#        define TRANSACTION_HANDLER_MASTER_SCHEDULED(prefix, id)                                        \
+            do {                                                                                        \
+                if (sync_scheduler_due(id)) {                                                           \
+                    if (sync_interval[id] == 0 || sync_cosmetic_budget > 0) {                           \
+                        TRANSACTION_HANDLER_MASTER(prefix);                                             \
+                    } else {                                                                            \
+                        sync_scheduler_defer(&prefix##_handlers_master, master_matrix, slave_matrix);   \
+                    }                                                                                   \
+                }                                                                                       \
+            } while (0)
+
+#    endif // SPLIT_SYNC_SCHEDULER_COSMETIC
+
+#    define TRANSACTIONS_SCHEDULER_MASTER() sync_scheduler_begin_scan()
+
+#else // SPLIT_SYNC_SCHEDULER
+
+#    define TRANSACTION_HANDLER_MASTER_SCHEDULED(prefix, id) TRANSACTION_HANDLER_MASTER(prefix)
+#    define TRANSACTIONS_SCHEDULER_MASTER()
+
+#endif // SPLIT_SYNC_SCHEDULER
+
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
     uint8_t curr_checksum;
     bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
     if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
         okay &= transport_read(trans_id_retrieve, destination, length);
-        okay &= curr_checksum == crc8(equiv_shmem, length);
+        if (okay && curr_checksum != crc8(equiv_shmem, length)) {
+            link_checksum_error(trans_id_retrieve);
+            okay = false;
+        }
         if (okay) {
             *last_update = timer_read32();
         }
@@ -170,9 +455,312 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
     return send_if_condition(trans_id, last_update, (memcmp(source, equiv_shmem, length) != 0), source, length);
 }
 
+////////////////////////////////////////////////////
+// Batching
+
+#ifdef SPLIT_TRANSACTION_BATCHING
+
+static uint8_t batch_frame_checksum(const split_batch_frame_t *frame) {
+    return crc8(&frame->sequence, offsetof(split_batch_frame_t, data) - offsetof(split_batch_frame_t, sequence) + frame->length);
+}
+
+static uint8_t batch_reply_checksum(const split_batch_reply_t *reply) {
+    return crc8(&reply->sequence, sizeof(split_batch_reply_t) - offsetof(split_batch_reply_t, sequence));
+}
+
+static void batch_build_frame(split_batch_frame_t *frame) {
+    frame->length = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; id++) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        uint8_t                   size  = trans->initiator2target_buffer_size;
+        // Whatever doesn't fit goes in the next frame
+        if (batch_is_pending(id) && frame->length + 1 + size <= sizeof(frame->data)) {
+            frame->data[frame->length++] = id;
+            memcpy(&frame->data[frame->length], split_trans_initiator2target_buffer(trans), size);
+            frame->length += size;
+            batch_pending[id / 8] &= ~(1 << (id % 8));
+        }
+    }
+
+    // Zero is what a slave that hasn't applied any frame yet reports
+    if (++frame->sequence == 0) {
+        frame->sequence = 1;
+    }
+    frame->checksum = batch_frame_checksum(frame);
+}
+
+static split_batch_frame_t batch_frame        = {0};
+static bool                batch_in_flight    = false; // frame not applied by the slave yet
+static bool                batch_awaiting_ack = false; // frame sent, the slave applies it on its next loop
+
+// Returns whether the next exchange should carry the frame
+static bool batch_prepare(void) {
+    if (!batch_in_flight && batch_any_pending()) {
+        batch_build_frame(&batch_frame);
+        batch_in_flight = true;
+    }
+    return batch_in_flight && !batch_awaiting_ack;
+}
+
+static bool batch_complete(bool okay, bool sent, const split_batch_reply_t *reply) {
+    if (okay && reply->checksum != batch_reply_checksum(reply)) {
+        link_checksum_error(sent ? EXCHANGE_BATCH : GET_BATCH_REPLY);
+        okay = false;
+    }
+
+    if (batch_in_flight) {
+        if (okay && reply->sequence == batch_frame.sequence) {
+            batch_in_flight    = false;
+            batch_awaiting_ack = false;
+        } else {
+            // Give the slave one more reply to acknowledge the frame, then send it again
+            batch_awaiting_ack = okay && sent;
+        }
+    }
+
+    if (okay) {
+        memcpy(&split_shmem->smatrix, &reply->smatrix, sizeof(reply->smatrix));
+#    ifdef SPLIT_MATRIX_DELTA_SYNC
+        memcpy(&split_shmem->smatrix_events, &reply->smatrix_events, sizeof(reply->smatrix_events));
+#    endif // SPLIT_MATRIX_DELTA_SYNC
+#    ifdef ENCODER_ENABLE
+        memcpy(&split_shmem->encoders, &reply->encoders, sizeof(reply->encoders));
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+        split_shmem->pointing.checksum = reply->pointing_checksum;
+        memcpy(&split_shmem->pointing.report, &reply->pointing_report, sizeof(reply->pointing_report));
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    }
+    return okay;
+}
+
+#    ifdef SPLIT_TRANSPORT_ASYNC
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static bool sent = false; // whether the exchange in progress carries the frame
+#        ifdef SPLIT_LINK_STATS_ENABLE
+    static uint32_t started = 0;
+#        endif // SPLIT_LINK_STATS_ENABLE
+    split_batch_reply_t reply;
+    bool                okay = true;
+
+    transport_async_status_t status = transport_poll_transaction(&reply, sizeof(reply));
+    if (status == TRANSPORT_ASYNC_BUSY) {
+        // Carry on with the last completed reply, the handlers below only see the previous exchange
+        return true;
+    }
+    if (status != TRANSPORT_ASYNC_IDLE) {
+#        ifdef SPLIT_LINK_STATS_ENABLE
+        // Includes the time until this scan noticed it was over
+        split_link_stats_record(sent ? EXCHANGE_BATCH : GET_BATCH_REPLY, status == TRANSPORT_ASYNC_DONE, timer_ticks_to_us(timer_read_ticks() - started));
+#        endif // SPLIT_LINK_STATS_ENABLE
+        okay = batch_complete(status == TRANSPORT_ASYNC_DONE, sent, &reply);
+    }
+
+    // The next exchange runs while the rest of this scan, and the next one, go ahead
+    sent = batch_prepare();
+#        ifdef SPLIT_LINK_STATS_ENABLE
+    started = timer_read_ticks();
+#        endif // SPLIT_LINK_STATS_ENABLE
+    if (sent) {
+        okay &= transport_start_transaction(EXCHANGE_BATCH, &batch_frame, sizeof(batch_frame));
+    } else {
+        okay &= transport_start_transaction(GET_BATCH_REPLY, NULL, 0);
+    }
+    return okay;
+}
+
+#    else // SPLIT_TRANSPORT_ASYNC
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_batch_reply_t reply;
+    bool                sent = batch_prepare();
+    bool                okay;
+
+    if (sent) {
+        okay = link_transaction(EXCHANGE_BATCH, &batch_frame, sizeof(batch_frame), &reply, sizeof(reply));
+    } else {
+        okay = link_transaction(GET_BATCH_REPLY, NULL, 0, &reply, sizeof(reply));
+    }
+    return batch_complete(okay, sent, &reply);
+}
+
+#    endif // SPLIT_TRANSPORT_ASYNC
+
+static void batch_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_batch_frame_t *frame = &split_shmem->batch_frame;
+    split_batch_reply_t *reply = &split_shmem->batch_reply;
+
+    if (frame->sequence == reply->sequence || frame->length > sizeof(frame->data) || frame->checksum != batch_frame_checksum(frame)) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < frame->length;) {
+        int8_t id = frame->data[i++];
+        if (id >= NUM_TOTAL_TRANSACTIONS) {
+            break;
+        }
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (i + trans->initiator2target_buffer_size > frame->length) {
+            break;
+        }
+        memcpy(split_trans_initiator2target_buffer(trans), &frame->data[i], trans->initiator2target_buffer_size);
+        i += trans->initiator2target_buffer_size;
+    }
+
+    reply->sequence = frame->sequence;
+    reply->checksum = batch_reply_checksum(reply);
+}
+
+static void batch_reply_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_batch_reply_t *reply = &split_shmem->batch_reply;
+
+    memcpy(&reply->smatrix, &split_shmem->smatrix, sizeof(reply->smatrix));
+#    ifdef SPLIT_MATRIX_DELTA_SYNC
+    memcpy(&reply->smatrix_events, &split_shmem->smatrix_events, sizeof(reply->smatrix_events));
+#    endif // SPLIT_MATRIX_DELTA_SYNC
+#    ifdef ENCODER_ENABLE
+    memcpy(&reply->encoders, &split_shmem->encoders, sizeof(reply->encoders));
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    reply->pointing_checksum = split_shmem->pointing.checksum;
+    memcpy(&reply->pointing_report, &split_shmem->pointing.report, sizeof(reply->pointing_report));
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    reply->checksum = batch_reply_checksum(reply);
+}
+
+// clang-format off
+#    ifdef SPLIT_TRANSPORT_ASYNC
+// Retrying would only find the exchange it just started still in progress
+#        define TRANSACTIONS_BATCH_MASTER()                                \
+            do {                                                           \
+                if (!batch_handlers_master(master_matrix, slave_matrix)) { \
+                    return false;                                          \
+                }                                                          \
+            } while (0)
+#    else
+#        define TRANSACTIONS_BATCH_MASTER() TRANSACTION_HANDLER_MASTER(batch)
+#    endif // SPLIT_TRANSPORT_ASYNC
+#    define TRANSACTIONS_BATCH_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(batch)
+#    define TRANSACTIONS_BATCH_REPLY_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(batch_reply)
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [EXCHANGE_BATCH]  = { sizeof_member(split_shared_memory_t, batch_frame), offsetof(split_shared_memory_t, batch_frame), sizeof_member(split_shared_memory_t, batch_reply), offsetof(split_shared_memory_t, batch_reply), NULL }, \
+    [GET_BATCH_REPLY] = trans_target2initiator_initializer(batch_reply),
+// clang-format on
+
+#else // SPLIT_TRANSACTION_BATCHING
+
+#    define TRANSACTIONS_BATCH_MASTER()
+#    define TRANSACTIONS_BATCH_SLAVE()
+#    define TRANSACTIONS_BATCH_REPLY_SLAVE()
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSACTION_BATCHING
+
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_MATRIX_DELTA_SYNC
+
+static uint8_t slave_matrix_checksum(const split_slave_matrix_sync_t *smatrix) {
+    return crc8_update(crc8(smatrix->matrix, sizeof(smatrix->matrix)), &smatrix->sequence, sizeof(smatrix->sequence));
+}
+
+static uint8_t slave_matrix_events_checksum(const split_slave_matrix_events_t *events) {
+    uint8_t checksum = crc8(&events->sequence, sizeof(events->sequence));
+    checksum         = crc8_update(checksum, &events->matrix_checksum, sizeof(events->matrix_checksum));
+    return crc8_update(checksum, events->events, sizeof(events->events));
+}
+
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static bool         in_sync                        = false;
+    static uint8_t      sequence                       = 0;   // of the next key change to apply
+    static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, with the key changes applied to it
+
+    bool okay = true;
+
+    if (in_sync) {
+        // A failed read leaves the key changes in the queue for the next one
+        split_slave_matrix_events_t events;
+        okay = transport_read(GET_SLAVE_MATRIX_EVENTS, &events, sizeof(events));
+        if (okay && events.checksum != slave_matrix_events_checksum(&events)) {
+            link_checksum_error(GET_SLAVE_MATRIX_EVENTS);
+            okay = false;
+        }
+        if (okay) {
+            if ((uint8_t)(events.sequence - sequence) > SPLIT_MATRIX_EVENT_QUEUE_SIZE) {
+                // Some key changes already left the queue, fall back to reading the whole matrix
+                in_sync = false;
+            } else {
+                for (; sequence != events.sequence; sequence++) {
+                    split_matrix_event_t *event = &events.events[sequence % SPLIT_MATRIX_EVENT_QUEUE_SIZE];
+                    if (event->pressed) {
+                        last_matrix[event->row] |= (MATRIX_ROW_SHIFTER << event->col);
+                    } else {
+                        last_matrix[event->row] &= ~(MATRIX_ROW_SHIFTER << event->col);
+                    }
+                }
+                // The slave restarted, and its sequence number happened to look like no changes were missed
+                if (crc8(last_matrix, sizeof(last_matrix)) != events.matrix_checksum) {
+                    in_sync = false;
+                }
+            }
+        }
+    }
+
+    if (!in_sync) {
+        split_slave_matrix_sync_t smatrix;
+        okay = transport_read(GET_SLAVE_MATRIX_DATA, &smatrix, sizeof(smatrix));
+        if (okay && smatrix.checksum != slave_matrix_checksum(&smatrix)) {
+            link_checksum_error(GET_SLAVE_MATRIX_DATA);
+            okay = false;
+        }
+        if (okay) {
+            memcpy(last_matrix, smatrix.matrix, sizeof(last_matrix));
+            sequence = smatrix.sequence;
+            in_sync  = true;
+        }
+    }
+
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_slave_matrix_events_t *events = &split_shmem->smatrix_events;
+
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+        matrix_row_t changes = slave_matrix[row] ^ split_shmem->smatrix.matrix[row];
+        for (uint8_t col = 0; changes; col++, changes >>= 1) {
+            if (changes & 1) {
+                split_matrix_event_t *event = &events->events[events->sequence % SPLIT_MATRIX_EVENT_QUEUE_SIZE];
+                event->time                 = sync_timer_read();
+                event->row                  = row;
+                event->col                  = col;
+                event->pressed              = (slave_matrix[row] >> col) & 1;
+                events->sequence++;
+            }
+        }
+    }
+
+    memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
+    split_shmem->smatrix.sequence = events->sequence;
+    split_shmem->smatrix.checksum = slave_matrix_checksum(&split_shmem->smatrix);
+    events->matrix_checksum       = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+    events->checksum              = slave_matrix_events_checksum(events);
+}
+
+// clang-format off
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+    [GET_SLAVE_MATRIX_EVENTS] = trans_target2initiator_initializer(smatrix_events), \
+    [GET_SLAVE_MATRIX_DATA]   = trans_target2initiator_initializer(smatrix),
+// clang-format on
+
+#else // SPLIT_MATRIX_DELTA_SYNC
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -194,13 +782,15 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 }
 
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+#endif // SPLIT_MATRIX_DELTA_SYNC
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -452,7 +1042,7 @@ static void backlight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     backlight_level_noeeprom(backlight_level);
 }
 
-#    define TRANSACTIONS_BACKLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(backlight)
+#    define TRANSACTIONS_BACKLIGHT_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(backlight, PUT_BACKLIGHT)
 #    define TRANSACTIONS_BACKLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(backlight)
 #    define TRANSACTIONS_BACKLIGHT_REGISTRATIONS [PUT_BACKLIGHT] = trans_initiator2target_initializer(backlight_level),
 
@@ -494,7 +1084,7 @@ static void rgblight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     }
 }
 
-#    define TRANSACTIONS_RGBLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(rgblight)
+#    define TRANSACTIONS_RGBLIGHT_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(rgblight, PUT_RGBLIGHT)
 #    define TRANSACTIONS_RGBLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(rgblight)
 #    define TRANSACTIONS_RGBLIGHT_REGISTRATIONS [PUT_RGBLIGHT] = trans_initiator2target_initializer(rgblight_sync),
 
@@ -528,7 +1118,7 @@ static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     led_matrix_set_suspend_state(led_suspend_state);
 }
 
-#    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(led_matrix)
+#    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(led_matrix, PUT_LED_MATRIX)
 #    define TRANSACTIONS_LED_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(led_matrix)
 #    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_initializer(led_matrix_sync),
 
@@ -562,7 +1152,7 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
     rgb_matrix_set_suspend_state(rgb_suspend_state);
 }
 
-#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
+#    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(rgb_matrix, PUT_RGB_MATRIX)
 #    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
 #    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
 
@@ -589,7 +1179,7 @@ static void wpm_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_
     set_current_wpm(split_shmem->current_wpm);
 }
 
-#    define TRANSACTIONS_WPM_MASTER() TRANSACTION_HANDLER_MASTER(wpm)
+#    define TRANSACTIONS_WPM_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(wpm, PUT_WPM)
 #    define TRANSACTIONS_WPM_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(wpm)
 #    define TRANSACTIONS_WPM_REGISTRATIONS [PUT_WPM] = trans_initiator2target_initializer(current_wpm),
 
@@ -624,7 +1214,7 @@ static void oled_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave
     }
 }
 
-#    define TRANSACTIONS_OLED_MASTER() TRANSACTION_HANDLER_MASTER(oled)
+#    define TRANSACTIONS_OLED_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(oled, PUT_OLED)
 #    define TRANSACTIONS_OLED_SLAVE() TRANSACTION_HANDLER_SLAVE(oled)
 #    define TRANSACTIONS_OLED_REGISTRATIONS [PUT_OLED] = trans_initiator2target_initializer(current_oled_state),
 
@@ -659,7 +1249,7 @@ static void st7565_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
     }
 }
 
-#    define TRANSACTIONS_ST7565_MASTER() TRANSACTION_HANDLER_MASTER(st7565)
+#    define TRANSACTIONS_ST7565_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(st7565, PUT_ST7565)
 #    define TRANSACTIONS_ST7565_SLAVE() TRANSACTION_HANDLER_SLAVE(st7565)
 #    define TRANSACTIONS_ST7565_REGISTRATIONS [PUT_ST7565] = trans_initiator2target_initializer(current_st7565_state),
 
@@ -799,6 +1389,12 @@ static bool haptic_handlers_master(matrix_row_t master_matrix[], matrix_row_t sl
 
     bool okay = send_if_data_mismatch(PUT_HAPTIC, &last_update, &haptic_sync, &split_shmem->haptic_sync, sizeof(haptic_sync));
 
+#    ifdef SPLIT_SYNC_SCHEDULER_COSMETIC
+    if (sync_deferring) {
+        // Still to be played once its turn comes
+        return okay;
+    }
+#    endif // SPLIT_SYNC_SCHEDULER_COSMETIC
     split_haptic_play = 0xFF;
 
     return okay;
@@ -814,7 +1410,7 @@ static void haptic_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sla
 }
 
 // clang-format off
-#    define TRANSACTIONS_HAPTIC_MASTER() TRANSACTION_HANDLER_MASTER(haptic)
+#    define TRANSACTIONS_HAPTIC_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(haptic, PUT_HAPTIC)
 #    define TRANSACTIONS_HAPTIC_SLAVE() TRANSACTION_HANDLER_SLAVE(haptic)
 #    define TRANSACTIONS_HAPTIC_REGISTRATIONS [PUT_HAPTIC] = trans_initiator2target_initializer(haptic_sync),
 // clang-format on
@@ -843,7 +1439,7 @@ static void activity_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 }
 
 // clang-format off
-#    define TRANSACTIONS_ACTIVITY_MASTER() TRANSACTION_HANDLER_MASTER(activity)
+#    define TRANSACTIONS_ACTIVITY_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(activity, PUT_ACTIVITY)
 #    define TRANSACTIONS_ACTIVITY_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(activity)
 #    define TRANSACTIONS_ACTIVITY_REGISTRATIONS [PUT_ACTIVITY] = trans_initiator2target_initializer(activity_sync),
 // clang-format on
@@ -872,7 +1468,7 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
     slave_update_detected_host_os(split_shmem->detected_os);
 }
 
-#    define TRANSACTIONS_DETECTED_OS_MASTER() TRANSACTION_HANDLER_MASTER(detected_os)
+#    define TRANSACTIONS_DETECTED_OS_MASTER() TRANSACTION_HANDLER_MASTER_SCHEDULED(detected_os, PUT_DETECTED_OS)
 #    define TRANSACTIONS_DETECTED_OS_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(detected_os)
 #    define TRANSACTIONS_DETECTED_OS_REGISTRATIONS [PUT_DETECTED_OS] = trans_initiator2target_initializer(detected_os),
 
@@ -884,6 +1480,203 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+////////////////////////////////////////////////////
+// RPC streams
+
+#ifdef SPLIT_RPC_STREAM_ENABLE
+
+enum {
+    RPC_STREAM_IDLE,
+    RPC_STREAM_RECEIVING,
+    RPC_STREAM_COMPLETE, // waiting for the slave to run the callback
+    RPC_STREAM_DONE,
+    RPC_STREAM_REJECTED,
+};
+
+typedef struct {
+    void                 *buffer;
+    uint16_t              buffer_size;
+    rpc_stream_received_t callback;
+} rpc_stream_target_t;
+
+// Master side: the stream being sent
+static struct {
+    const uint8_t    *data;
+    rpc_stream_sent_t callback;
+    uint16_t          length;
+    uint16_t          sent;  // offset of the next chunk
+    uint16_t          acked; // bytes the slave is known to have
+    int8_t            transaction_id;
+    uint8_t           stream;
+    uint8_t           failures;
+    bool              active;
+    bool              started; // once a stream number has been picked
+} rpc_stream;
+
+// Slave side: where streams go, indexed from the first custom transaction ID
+static rpc_stream_target_t rpc_stream_targets[NUM_TOTAL_TRANSACTIONS - GET_RPC_RESP_DATA - 1];
+static int8_t              rpc_stream_receiver = -1;
+
+static rpc_stream_target_t *rpc_stream_target(int8_t transaction_id) {
+    if (transaction_id <= GET_RPC_RESP_DATA || transaction_id >= NUM_TOTAL_TRANSACTIONS) {
+        return NULL;
+    }
+    return &rpc_stream_targets[transaction_id - GET_RPC_RESP_DATA - 1];
+}
+
+static void rpc_stream_finish(bool success) {
+    rpc_stream.active = false;
+    if (rpc_stream.callback) {
+        rpc_stream.callback(rpc_stream.transaction_id, success);
+    }
+}
+
+static bool rpc_stream_read_ack(rpc_stream_ack_t *ack) {
+    if (!transport_read(GET_RPC_STREAM_ACK, ack, sizeof(*ack))) {
+        return false;
+    }
+    if (crc8(&ack->payload, sizeof(ack->payload)) != ack->checksum) {
+        link_checksum_error(GET_RPC_STREAM_ACK);
+        return false;
+    }
+    return true;
+}
+
+static bool rpc_stream_send_window(void) {
+    uint8_t chunks = 0;
+    do {
+        rpc_stream_chunk_t chunk = {.payload = {.transaction_id = rpc_stream.transaction_id, .stream = rpc_stream.stream, .offset = rpc_stream.sent, .length = rpc_stream.length}};
+        chunk.payload.size       = MIN(SPLIT_RPC_STREAM_CHUNK_SIZE, rpc_stream.length - rpc_stream.sent);
+        memcpy(chunk.payload.data, rpc_stream.data + rpc_stream.sent, chunk.payload.size);
+        chunk.checksum = crc8(&chunk.payload, sizeof(chunk.payload));
+
+        if (!transport_write(PUT_RPC_STREAM_CHUNK, &chunk, sizeof(chunk))) {
+            return false;
+        }
+        rpc_stream.sent += chunk.payload.size;
+    } while (++chunks < SPLIT_RPC_STREAM_WINDOW && rpc_stream.sent < rpc_stream.length);
+    return true;
+}
+
+static bool rpc_stream_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (!rpc_stream.active) {
+        return true;
+    }
+
+    rpc_stream_ack_t ack;
+    bool             okay = true;
+    if (!rpc_stream.started) {
+        // Start from a stream number the slave isn't holding on to, in case either side restarted
+        okay = rpc_stream_read_ack(&ack);
+        if (okay) {
+            rpc_stream.stream  = ack.payload.stream + 1;
+            rpc_stream.started = true;
+        }
+    }
+
+    if (okay && (rpc_stream.sent < rpc_stream.length || rpc_stream.length == 0)) {
+        okay = rpc_stream_send_window();
+    }
+    okay = okay && rpc_stream_read_ack(&ack);
+
+    if (okay && ack.payload.stream != rpc_stream.stream) {
+        // Still busy with the previous stream, or restarted since this one began
+        rpc_stream.acked = 0;
+        okay             = false;
+    }
+
+    if (!okay) {
+        // Go back to the first byte the slave is known to be missing, the rest may not have arrived
+        rpc_stream.sent = rpc_stream.acked;
+        if (++rpc_stream.failures >= SPLIT_RPC_STREAM_RETRIES) {
+            dprintf("Failed to stream RPC %d\n", rpc_stream.transaction_id);
+            rpc_stream_finish(false);
+        }
+        // Don't count against the link, the other transactions will notice if it's down
+        return true;
+    }
+
+    rpc_stream.failures = 0;
+    switch (ack.payload.status) {
+        case RPC_STREAM_COMPLETE:
+        case RPC_STREAM_DONE:
+            rpc_stream_finish(true);
+            break;
+        case RPC_STREAM_RECEIVING:
+            // Chunks after a lost one are dropped by the slave, so carry on from there
+            rpc_stream.acked = ack.payload.received;
+            rpc_stream.sent  = ack.payload.received;
+            break;
+        default:
+            rpc_stream_finish(false);
+            break;
+    }
+    return true;
+}
+
+static void rpc_stream_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    rpc_stream_ack_t *ack = &split_shmem->rpc_stream_ack;
+
+    // Buffer contents stay put until the ack is marked done, new streams are turned away until then
+    if (ack->payload.status != RPC_STREAM_COMPLETE) {
+        return;
+    }
+
+    rpc_stream_target_t *target = rpc_stream_target(rpc_stream_receiver);
+    if (target && target->callback) {
+        target->callback(rpc_stream_receiver, ack->payload.received, target->buffer);
+    }
+
+    split_shared_memory_lock();
+    ack->payload.status = RPC_STREAM_DONE;
+    ack->checksum       = crc8(&ack->payload, sizeof(ack->payload));
+    split_shared_memory_unlock();
+}
+
+// Runs for the ack as well as for every chunk: transports that call back before receiving the initiator's
+// buffer then take in the previous chunk instead, and the last chunk is in place before the ack goes out.
+static void slave_rpc_stream_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    rpc_stream_chunk_t *chunk = &split_shmem->rpc_stream_chunk;
+    rpc_stream_ack_t   *ack   = &split_shmem->rpc_stream_ack;
+
+    // Nothing to take in, but the ack must still be valid for the master to pick a stream number
+    bool valid = crc8(&chunk->payload, sizeof(chunk->payload)) == chunk->checksum;
+
+    // A new stream may only begin at its start, once the previous one has been handed over
+    if (valid && chunk->payload.stream != ack->payload.stream && chunk->payload.offset == 0 && ack->payload.status != RPC_STREAM_COMPLETE) {
+        rpc_stream_target_t *target = rpc_stream_target(chunk->payload.transaction_id);
+        rpc_stream_receiver         = chunk->payload.transaction_id;
+        ack->payload.stream         = chunk->payload.stream;
+        ack->payload.received       = 0;
+        ack->payload.status         = (target && target->buffer && chunk->payload.length <= target->buffer_size) ? RPC_STREAM_RECEIVING : RPC_STREAM_REJECTED;
+    }
+
+    if (valid && chunk->payload.stream == ack->payload.stream && ack->payload.status == RPC_STREAM_RECEIVING && chunk->payload.offset == ack->payload.received && chunk->payload.size <= SPLIT_RPC_STREAM_CHUNK_SIZE && chunk->payload.size <= chunk->payload.length - ack->payload.received) {
+        rpc_stream_target_t *target = rpc_stream_target(rpc_stream_receiver);
+        memcpy((uint8_t *)target->buffer + chunk->payload.offset, chunk->payload.data, chunk->payload.size);
+        ack->payload.received += chunk->payload.size;
+        if (ack->payload.received == chunk->payload.length) {
+            ack->payload.status = RPC_STREAM_COMPLETE;
+        }
+    }
+
+    ack->checksum = crc8(&ack->payload, sizeof(ack->payload));
+}
+
+#    define TRANSACTIONS_RPC_STREAM_MASTER() TRANSACTION_HANDLER_MASTER(rpc_stream)
+#    define TRANSACTIONS_RPC_STREAM_SLAVE() TRANSACTION_HANDLER_SLAVE(rpc_stream)
+#    define TRANSACTIONS_RPC_STREAM_REGISTRATIONS                                                                    \
+        [PUT_RPC_STREAM_CHUNK] = trans_initiator2target_initializer_cb(rpc_stream_chunk, slave_rpc_stream_callback), \
+        [GET_RPC_STREAM_ACK]   = trans_target2initiator_initializer_cb(rpc_stream_ack, slave_rpc_stream_callback),
+
+#else // SPLIT_RPC_STREAM_ENABLE
+
+#    define TRANSACTIONS_RPC_STREAM_MASTER()
+#    define TRANSACTIONS_RPC_STREAM_SLAVE()
+#    define TRANSACTIONS_RPC_STREAM_REGISTRATIONS
+
+#endif // SPLIT_RPC_STREAM_ENABLE
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -895,6 +1688,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // USE_I2C
 
     // clang-format off
+    TRANSACTIONS_BATCH_REGISTRATIONS
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
@@ -914,6 +1708,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_HAPTIC_REGISTRATIONS
     TRANSACTIONS_ACTIVITY_REGISTRATIONS
     TRANSACTIONS_DETECTED_OS_REGISTRATIONS
+    TRANSACTIONS_RPC_STREAM_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -925,6 +1720,8 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTIONS_SCHEDULER_MASTER();
+    TRANSACTIONS_BATCH_MASTER();
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -944,10 +1741,12 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    TRANSACTIONS_RPC_STREAM_MASTER();
     return true;
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTIONS_BATCH_SLAVE();
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
     TRANSACTIONS_ENCODERS_SLAVE();
@@ -967,6 +1766,8 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_HAPTIC_SLAVE();
     TRANSACTIONS_ACTIVITY_SLAVE();
     TRANSACTIONS_DETECTED_OS_SLAVE();
+    TRANSACTIONS_RPC_STREAM_SLAVE();
+    TRANSACTIONS_BATCH_REPLY_SLAVE();
 }
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -1046,4 +1847,45 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
     }
 }
 
+#    ifdef SPLIT_RPC_STREAM_ENABLE
+
+void transaction_register_rpc_stream(int8_t transaction_id, void *buffer, uint16_t buffer_size, rpc_stream_received_t callback) {
+    rpc_stream_target_t *target = rpc_stream_target(transaction_id);
+    if (!target) return;
+
+    split_shared_memory_lock();
+    target->buffer      = buffer;
+    target->buffer_size = buffer_size;
+    target->callback    = callback;
+    split_shared_memory_unlock();
+}
+
+bool transaction_rpc_stream(int8_t transaction_id, uint16_t length, const void *data, rpc_stream_sent_t callback) {
+    // Prevent transaction attempts while transport is disconnected
+    if (!is_transport_connected()) {
+        return false;
+    }
+    // Prevent invoking RPC on QMK core sync data
+    if (!rpc_stream_target(transaction_id)) return false;
+    // One stream at a time
+    if (rpc_stream.active) return false;
+
+    rpc_stream.data           = data;
+    rpc_stream.callback       = callback;
+    rpc_stream.length         = length;
+    rpc_stream.sent           = 0;
+    rpc_stream.acked          = 0;
+    rpc_stream.transaction_id = transaction_id;
+    rpc_stream.failures       = 0;
+    rpc_stream.started        = false;
+    rpc_stream.active         = true;
+    return true;
+}
+
+bool transaction_rpc_stream_busy(void) {
+    return rpc_stream.active;
+}
+
+#    endif // SPLIT_RPC_STREAM_ENABLE
+
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
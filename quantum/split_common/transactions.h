@@ -51,3 +51,36 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
 
 #define transaction_rpc_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL)
 #define transaction_rpc_recv(transaction_id, target2initiator_buffer_size, target2initiator_buffer) transaction_rpc_exec(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer)
+
+#ifdef SPLIT_RPC_STREAM_ENABLE
+// Called on the master once the slave has the whole stream, or the transfer was given up on
+typedef void (*rpc_stream_sent_t)(int8_t transaction_id, bool success);
+// Called on the slave from its scan once the whole stream is in the registered buffer
+typedef void (*rpc_stream_received_t)(int8_t transaction_id, uint16_t length, void *buffer);
+
+// Streams sent with this ID are written to `buffer`, and rejected if they don't fit
+void transaction_register_rpc_stream(int8_t transaction_id, void *buffer, uint16_t buffer_size, rpc_stream_received_t callback);
+
+// Queues `data` for transfer in the background of the next scans, it must stay valid until `callback` is called
+bool transaction_rpc_stream(int8_t transaction_id, uint16_t length, const void *data, rpc_stream_sent_t callback);
+bool transaction_rpc_stream_busy(void);
+#endif // SPLIT_RPC_STREAM_ENABLE
+
+#ifdef SPLIT_SYNC_SCHEDULER
+// Link utilization, counted by the master since the last reset
+typedef struct {
+    uint32_t scans;        // runs of transactions_master()
+    uint32_t transactions; // transactions attempted, including the ones folded into a batch
+    uint32_t cosmetic;     // of which rate-limited
+    uint32_t deferred;     // cosmetic transactions put off to a later scan for lack of budget
+    uint32_t bytes;        // buffer bytes moved in either direction
+    uint8_t  max_per_scan; // most transactions attempted during a single scan
+} split_sync_stats_t;
+
+// Minimum time between two syncs of a rate-limited transaction, 0 syncs it on every scan
+void     split_sync_set_interval(int8_t transaction_id, uint16_t interval_ms);
+uint16_t split_sync_get_interval(int8_t transaction_id);
+
+void split_sync_get_stats(split_sync_stats_t *stats);
+void split_sync_reset_stats(void);
+#endif // SPLIT_SYNC_SCHEDULER
@@ -35,6 +35,10 @@
 #    include "i2c_master.h"
 #    include "i2c_slave.h"
 
+#    ifdef SPLIT_TRANSPORT_ASYNC
+#        error "SPLIT_TRANSPORT_ASYNC is not supported by the I2C transport"
+#    endif // SPLIT_TRANSPORT_ASYNC
+
 // Ensure the I2C buffer has enough space
 _Static_assert(sizeof(split_shared_memory_t) <= I2C_SLAVE_REG_COUNT, "split_shared_memory_t too large for I2C_SLAVE_REG_COUNT");
 
@@ -90,6 +94,10 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 
 #    include "serial.h"
 
+#    if defined(SPLIT_TRANSPORT_ASYNC) && defined(SERIAL_DRIVER_BITBANG)
+#        error "SPLIT_TRANSPORT_ASYNC is not supported by the bitbang serial driver"
+#    endif // defined(SPLIT_TRANSPORT_ASYNC) && defined(SERIAL_DRIVER_BITBANG)
+
 static split_shared_memory_t shared_memory;
 split_shared_memory_t *const split_shmem = &shared_memory;
 
@@ -119,6 +127,52 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_TRANSPORT_ASYNC
+
+static int8_t async_transaction_id = -1; // started and not collected yet
+
+bool transport_start_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length) {
+    // The driver may still be sending the buffers of the previous one
+    if (async_transaction_id >= 0) {
+        return false;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    if (!soft_serial_transaction_start(id)) {
+        return false;
+    }
+
+    async_transaction_id = id;
+    return true;
+}
+
+transport_async_status_t transport_poll_transaction(void *target2initiator_buf, uint16_t target2initiator_length) {
+    if (async_transaction_id < 0) {
+        return TRANSPORT_ASYNC_IDLE;
+    }
+
+    transport_async_status_t status = soft_serial_transaction_poll();
+    if (status == TRANSPORT_ASYNC_BUSY) {
+        return status;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[async_transaction_id];
+    if (status == TRANSPORT_ASYNC_DONE && target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+
+    async_transaction_id = -1;
+    return status;
+}
+
+#    endif // SPLIT_TRANSPORT_ASYNC
+
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
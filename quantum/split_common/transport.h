@@ -40,6 +40,28 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#if defined(SPLIT_RPC_STREAM_ENABLE) && !(defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER))
+#    error "SPLIT_RPC_STREAM_ENABLE requires SPLIT_TRANSACTION_IDS_KB or SPLIT_TRANSACTION_IDS_USER"
+#endif
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+#    ifndef SPLIT_TRANSACTION_BATCHING
+#        error "SPLIT_TRANSPORT_ASYNC requires SPLIT_TRANSACTION_BATCHING"
+#    endif
+
+typedef enum {
+    TRANSPORT_ASYNC_IDLE,   // nothing started since the last result was collected
+    TRANSPORT_ASYNC_BUSY,   // still on the wire
+    TRANSPORT_ASYNC_DONE,   // completed, reported once
+    TRANSPORT_ASYNC_FAILED, // failed or timed out, reported once
+} transport_async_status_t;
+
+// Starts a transaction in the background, returns false if the previous one hasn't been collected yet
+bool transport_start_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length);
+// Collects the result of the background transaction, copying what the slave sent back once it's done
+transport_async_status_t transport_poll_transaction(void *target2initiator_buf, uint16_t target2initiator_length);
+#endif // SPLIT_TRANSPORT_ASYNC
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -52,8 +74,38 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 #    include "rgblight.h"
 #endif // RGBLIGHT_ENABLE
 
+#ifdef SPLIT_MATRIX_DELTA_SYNC
+// Must be a power of two, and no larger than 128
+#    ifndef SPLIT_MATRIX_EVENT_QUEUE_SIZE
+#        define SPLIT_MATRIX_EVENT_QUEUE_SIZE 4
+#    endif
+
+#    if (SPLIT_MATRIX_EVENT_QUEUE_SIZE & (SPLIT_MATRIX_EVENT_QUEUE_SIZE - 1)) != 0 || SPLIT_MATRIX_EVENT_QUEUE_SIZE > 128
+#        error SPLIT_MATRIX_EVENT_QUEUE_SIZE must be a power of two no larger than 128
+#    endif
+
+typedef struct _split_matrix_event_t {
+    uint16_t time; // sync_timer_read() when the slave saw the change
+    uint8_t  row;  // relative to the slave half
+    uint8_t  col : 7;
+    uint8_t  pressed : 1;
+} split_matrix_event_t;
+
+// The last SPLIT_MATRIX_EVENT_QUEUE_SIZE key changes on the slave, the one
+// numbered `sequence - 1` being the latest
+typedef struct _split_slave_matrix_events_t {
+    uint8_t              checksum;
+    uint8_t              sequence;
+    uint8_t              matrix_checksum; // of the slave matrix with all the changes applied
+    split_matrix_event_t events[SPLIT_MATRIX_EVENT_QUEUE_SIZE];
+} split_slave_matrix_events_t;
+#endif // SPLIT_MATRIX_DELTA_SYNC
+
 typedef struct _split_slave_matrix_sync_t {
     uint8_t      checksum;
+#ifdef SPLIT_MATRIX_DELTA_SYNC
+    uint8_t      sequence; // of the first key change not included in the matrix
+#endif // SPLIT_MATRIX_DELTA_SYNC
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
@@ -131,6 +183,37 @@ typedef struct _split_slave_activity_sync_t {
 } split_slave_activity_sync_t;
 #endif // defined(SPLIT_ACTIVITY_ENABLE)
 
+#ifdef SPLIT_TRANSACTION_BATCHING
+#    ifndef SPLIT_BATCH_FRAME_SIZE
+#        define SPLIT_BATCH_FRAME_SIZE 32
+#    endif
+
+// Transactions written by the master during a scan, sent together at the start of the next one
+typedef struct _split_batch_frame_t {
+    uint8_t checksum;
+    uint8_t sequence;
+    uint8_t length;
+    uint8_t data[SPLIT_BATCH_FRAME_SIZE]; // transaction ID followed by its buffer, for each transaction
+} split_batch_frame_t;
+
+// Everything the master reads from the slave, in one go at the start of every scan
+typedef struct _split_batch_reply_t {
+    uint8_t                   checksum;
+    uint8_t                   sequence; // of the last frame applied by the slave
+    split_slave_matrix_sync_t smatrix;
+#    ifdef SPLIT_MATRIX_DELTA_SYNC
+    split_slave_matrix_events_t smatrix_events;
+#    endif // SPLIT_MATRIX_DELTA_SYNC
+#    ifdef ENCODER_ENABLE
+    split_slave_encoder_sync_t encoders;
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    uint8_t        pointing_checksum;
+    report_mouse_t pointing_report;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+} split_batch_reply_t;
+#endif // SPLIT_TRANSACTION_BATCHING
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 typedef struct _rpc_sync_info_t {
     uint8_t checksum;
@@ -140,6 +223,35 @@ typedef struct _rpc_sync_info_t {
         uint8_t s2m_length;
     } payload;
 } rpc_sync_info_t;
+
+#    ifdef SPLIT_RPC_STREAM_ENABLE
+#        ifndef SPLIT_RPC_STREAM_CHUNK_SIZE
+#            define SPLIT_RPC_STREAM_CHUNK_SIZE 32
+#        endif // SPLIT_RPC_STREAM_CHUNK_SIZE
+
+// One chunk of a stream, placed at `offset` in the slave's buffer
+typedef struct _rpc_stream_chunk_t {
+    uint8_t checksum;
+    struct {
+        int8_t   transaction_id;
+        uint8_t  stream; // differs from the previous stream's
+        uint16_t offset;
+        uint16_t length; // of the whole stream
+        uint8_t  size;   // of this chunk
+        uint8_t  data[SPLIT_RPC_STREAM_CHUNK_SIZE];
+    } payload;
+} rpc_stream_chunk_t;
+
+// How far the slave got with the current stream
+typedef struct _rpc_stream_ack_t {
+    uint8_t checksum;
+    struct {
+        uint8_t  stream;
+        uint8_t  status;
+        uint16_t received; // bytes stored without gaps from the start of the stream
+    } payload;
+} rpc_stream_ack_t;
+#    endif // SPLIT_RPC_STREAM_ENABLE
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
@@ -151,8 +263,17 @@ typedef struct _split_shared_memory_t {
     int8_t transaction_id;
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSACTION_BATCHING
+    split_batch_frame_t batch_frame;
+    split_batch_reply_t batch_reply;
+#endif // SPLIT_TRANSACTION_BATCHING
+
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_MATRIX_DELTA_SYNC
+    split_slave_matrix_events_t smatrix_events;
+#endif // SPLIT_MATRIX_DELTA_SYNC
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -225,6 +346,10 @@ typedef struct _split_shared_memory_t {
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
     uint8_t         rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
+#    ifdef SPLIT_RPC_STREAM_ENABLE
+    rpc_stream_chunk_t rpc_stream_chunk;
+    rpc_stream_ack_t   rpc_stream_ack;
+#    endif // SPLIT_RPC_STREAM_ENABLE
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
@@ -26,11 +26,13 @@
 
 #include "raw_hid.h"
 #include "dynamic_keymap.h"
+#include "crc.h"
 #include "eeprom.h"
 #include "eeconfig.h"
 #include "matrix.h"
 #include "timer.h"
 #include "wait.h"
+#include "util.h"
 #include "version.h" // for QMK_BUILDDATE used in EEPROM magic
 
 #if defined(AUDIO_ENABLE)
@@ -57,6 +59,14 @@
 #    include "led_matrix.h"
 #endif
 
+#if defined(LATENCY_TRACE_ENABLE)
+#    include "latency_trace.h"
+#endif
+
+#if defined(SPLIT_LINK_STATS_ENABLE)
+#    include "link_stats.h"
+#endif
+
 // Can be called in an overriding via_init_kb() to test if keyboard level code usage of
 // EEPROM is invalid and use/save defaults.
 bool via_eeprom_is_valid(void) {
@@ -112,6 +122,7 @@ void eeconfig_init_via(void) {
     dynamic_keymap_reset();
     // This resets the macros in EEPROM to nothing.
     dynamic_keymap_macro_reset();
+    dynamic_keymap_flush();
     // Save the magic number last, in case saving was interrupted
     via_eeprom_set_valid(true);
 }
@@ -276,6 +287,130 @@ __attribute__((weak)) bool via_command_kb(uint8_t *data, uint8_t length) {
     return false;
 }
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// Without the RAM mirror, stream data would be written to EEPROM before its
+// CRC was checked, so stream transfers are only supported with it.
+static struct {
+    uint8_t  region; // via_stream_region_id, or 0 when no transfer is in progress
+    uint16_t offset;
+    uint16_t size;
+    uint16_t received;
+    uint8_t  sequence; // of the next data report
+    uint8_t  crc;
+    bool     out_of_sequence;
+} via_stream;
+
+static uint16_t via_stream_region_size(uint8_t region) {
+    switch (region) {
+        case id_stream_keymap:
+            return dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+        case id_stream_macros:
+            return dynamic_keymap_macro_get_buffer_size();
+        default:
+            return 0;
+    }
+}
+
+// The transaction is dropped by dynamic_keymap_task() when the host goes
+// quiet in the middle of a transfer.
+static bool via_stream_active(void) {
+    if (via_stream.region && !dynamic_keymap_in_transaction()) {
+        via_stream.region = 0;
+    }
+    return via_stream.region != 0;
+}
+
+static void via_stream_abandon(void) {
+    if (via_stream_active()) {
+        dynamic_keymap_end_transaction(false);
+        via_stream.region = 0;
+    }
+}
+
+static void via_stream_begin(uint8_t *command_data, uint8_t payload_size) {
+    uint8_t  region      = command_data[0];
+    uint16_t offset      = (command_data[1] << 8) | command_data[2];
+    uint16_t size        = (command_data[3] << 8) | command_data[4];
+    uint16_t region_size = via_stream_region_size(region);
+
+    via_stream_abandon();
+
+    if (size == 0 || offset >= region_size || size > region_size - offset) {
+        command_data[0] = id_stream_invalid;
+        return;
+    }
+
+    via_stream.region          = region;
+    via_stream.offset          = offset;
+    via_stream.size            = size;
+    via_stream.received        = 0;
+    via_stream.sequence        = 0;
+    via_stream.crc             = 0xFF;
+    via_stream.out_of_sequence = false;
+    dynamic_keymap_begin_transaction();
+
+    command_data[0] = id_stream_ok;
+    command_data[1] = VIA_STREAM_WINDOW;
+    command_data[2] = payload_size;
+}
+
+// Returns true if the data report needs a reply
+static bool via_stream_data(uint8_t *command_data, uint8_t payload_size) {
+    uint8_t  sequence = command_data[0];
+    uint8_t *payload  = &command_data[1];
+
+    if (!via_stream_active()) {
+        command_data[0] = id_stream_not_started;
+        return true;
+    }
+
+    if (sequence != via_stream.sequence) {
+        // Ask for the missing report only once, and drop the ones after it
+        if (via_stream.out_of_sequence) {
+            return false;
+        }
+        via_stream.out_of_sequence = true;
+        command_data[0]            = id_stream_out_of_sequence;
+        command_data[1]            = via_stream.sequence;
+        return true;
+    }
+    via_stream.out_of_sequence = false;
+
+    uint16_t length = MIN(payload_size, via_stream.size - via_stream.received);
+    if (via_stream.region == id_stream_keymap) {
+        dynamic_keymap_set_buffer(via_stream.offset + via_stream.received, length, payload);
+    } else {
+        dynamic_keymap_macro_set_buffer(via_stream.offset + via_stream.received, length, payload);
+    }
+    via_stream.crc = crc8_update(via_stream.crc, payload, length);
+    via_stream.received += length;
+    via_stream.sequence++;
+
+    if (via_stream.sequence % VIA_STREAM_WINDOW == 0 || via_stream.received == via_stream.size) {
+        command_data[0] = id_stream_ok;
+        command_data[1] = via_stream.sequence;
+        return true;
+    }
+    return false;
+}
+
+static void via_stream_end(uint8_t *command_data) {
+    if (!via_stream_active()) {
+        command_data[0] = id_stream_not_started;
+    } else if (via_stream.received != via_stream.size) {
+        command_data[0] = id_stream_incomplete;
+    } else if (via_stream.crc != command_data[0]) {
+        command_data[0] = id_stream_crc_mismatch;
+    } else {
+        command_data[0] = id_stream_ok;
+        dynamic_keymap_end_transaction(true);
+        via_stream.region = 0;
+        return;
+    }
+    via_stream_abandon();
+}
+#endif
+
 void raw_hid_receive(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
@@ -286,6 +421,12 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
         return;
     }
 
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    if (*command_id != id_dynamic_keymap_stream_data && *command_id != id_dynamic_keymap_stream_end) {
+        via_stream_abandon();
+    }
+#endif
+
     switch (*command_id) {
         case id_get_protocol_version: {
             command_data[0] = VIA_PROTOCOL_VERSION >> 8;
@@ -337,6 +478,13 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
                     command_data[4] = value & 0xFF;
                     break;
                 }
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+                case id_stream_info: {
+                    command_data[1] = VIA_STREAM_WINDOW;
+                    command_data[2] = length - 2;
+                    break;
+                }
+#endif
                 default: {
                     // The value ID is not known
                     // Return the unhandled state
@@ -447,8 +595,34 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
             dynamic_keymap_set_encoder(command_data[0], command_data[1], command_data[2] != 0, (command_data[3] << 8) | command_data[4]);
             break;
         }
+#endif
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+        case id_dynamic_keymap_stream_begin: {
+            via_stream_begin(command_data, length - 2);
+            break;
+        }
+        case id_dynamic_keymap_stream_data: {
+            if (!via_stream_data(command_data, length - 2)) {
+                return;
+            }
+            break;
+        }
+        case id_dynamic_keymap_stream_end: {
+            via_stream_end(command_data);
+            break;
+        }
 #endif
         default: {
+#ifdef LATENCY_TRACE_ENABLE
+            if (latency_trace_raw_hid_receive(data, length)) {
+                break;
+            }
+#endif
+#ifdef SPLIT_LINK_STATS_ENABLE
+            if (split_link_stats_raw_hid_receive(data, length)) {
+                break;
+            }
+#endif
             // The command ID is not known
             // Return the unhandled state
             *command_id = id_unhandled;
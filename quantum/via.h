@@ -71,6 +71,12 @@
 #    define VIA_FIRMWARE_VERSION 0x00000000
 #endif
 
+// Number of data reports of a stream transfer after which the firmware
+// acknowledges the ones received so far.
+#ifndef VIA_STREAM_WINDOW
+#    define VIA_STREAM_WINDOW 16
+#endif
+
 enum via_command_id {
     id_get_protocol_version                 = 0x01, // always 0x01
     id_get_keyboard_value                   = 0x02,
@@ -93,15 +99,56 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_dynamic_keymap_stream_begin          = 0x16,
+    id_dynamic_keymap_stream_data           = 0x17,
+    id_dynamic_keymap_stream_end            = 0x18,
     id_unhandled                            = 0xFF,
 };
 
+// Stream transfers write a whole keymap or macro buffer without waiting for
+// a reply to every report. Hosts check for them with id_get_keyboard_value:
+//
+// info:  [ 0x02, id_stream_info ]
+//     -> [ 0x02, id_stream_info, window, payload_size ]
+//
+// Firmware without them, which includes firmware without
+// DYNAMIC_KEYMAP_RAM_MIRROR, replies id_unhandled to that and to the commands.
+//
+// begin: [ 0x16, region_id, offset_hi, offset_lo, size_hi, size_lo ]
+//     -> [ 0x16, status, window, payload_size ]
+// data:  [ 0x17, sequence, payload_size bytes of data ]
+//     -> [ 0x17, status, next_sequence ], only every window reports, at the
+//        end of the data, and once when a report is missing, in which case
+//        the host starts again from next_sequence
+// end:   [ 0x18, crc8 of the data ]
+//     -> [ 0x18, status ]
+//
+// The data is only written to EEPROM once the CRC matched, and until then the
+// keyboard keeps using the keymap and macros from before the transfer. Any
+// other command abandons a transfer in progress, and so does a pause of
+// DYNAMIC_KEYMAP_TRANSACTION_TIMEOUT milliseconds between data reports, after
+// which data and end reply id_stream_not_started.
+enum via_stream_region_id {
+    id_stream_keymap = 0x01,
+    id_stream_macros = 0x02,
+};
+
+enum via_stream_status {
+    id_stream_ok              = 0x00,
+    id_stream_invalid         = 0x01,
+    id_stream_not_started     = 0x02,
+    id_stream_out_of_sequence = 0x03,
+    id_stream_incomplete      = 0x04,
+    id_stream_crc_mismatch    = 0x05,
+};
+
 enum via_keyboard_value_id {
     id_uptime              = 0x01,
     id_layout_options      = 0x02,
     id_switch_matrix_state = 0x03,
     id_firmware_version    = 0x04,
     id_device_indication   = 0x05,
+    id_stream_info         = 0x06,
 };
 
 enum via_channel_id {
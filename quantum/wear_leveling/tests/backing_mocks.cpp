@@ -23,6 +23,11 @@ void MockBackingStore::reset_instance() {
     backing_erase_invoke_count  = 0;
     backing_write_invoke_count  = 0;
     backing_lock_invoke_count   = 0;
+    backing_read_invoke_count   = 0;
+
+    backing_write_bulk_invoke_count = 0;
+    backing_read_bulk_invoke_count  = 0;
+    backing_erase_step_invoke_count = 0;
 
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
@@ -30,6 +35,8 @@ void MockBackingStore::reset_instance() {
     write_success_callback  = [](std::uint64_t, std::uint32_t) { return true; };
     lock_success_callback   = [](std::uint64_t) { return true; };
 
+    read_bulk_success_callback = [](std::uint64_t, std::uint32_t) { return true; };
+
     write_log.clear();
 }
 
@@ -75,6 +82,26 @@ bool MockBackingStore::erase(void) {
     return true;
 }
 
+#ifdef MOCK_BACKING_STORE_ERASE_STEP_SIZE
+bool MockBackingStore::erase_step(std::size_t step) {
+    ++backing_erase_step_invoke_count;
+
+    EXPECT_TRUE(step < WEAR_LEVELING_BACKING_SIZE / MOCK_BACKING_STORE_ERASE_STEP_SIZE) << "Erase step is out of range";
+    if (erase_success_callback && !erase_success_callback(backing_erase_step_invoke_count)) {
+        return false;
+    }
+
+    // Only the slots covered by this step are erased
+    const std::size_t first = step * (MOCK_BACKING_STORE_ERASE_STEP_SIZE / BACKING_STORE_WRITE_SIZE);
+    for (std::size_t i = 0; i < MOCK_BACKING_STORE_ERASE_STEP_SIZE / BACKING_STORE_WRITE_SIZE; ++i) {
+        backing_storage[first + i].erase();
+    }
+
+    ++backing_erasure_count;
+    return true;
+}
+#endif // MOCK_BACKING_STORE_ERASE_STEP_SIZE
+
 bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     ++backing_write_invoke_count;
 
@@ -114,6 +141,8 @@ bool MockBackingStore::lock(void) {
 }
 
 bool MockBackingStore::read(uint32_t address, backing_store_int_t& value) const {
+    ++backing_read_invoke_count;
+
     // precondition: value's buffer size already matches BACKING_STORE_WRITE_SIZE
     EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
     EXPECT_TRUE(address + BACKING_STORE_WRITE_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
@@ -125,6 +154,36 @@ bool MockBackingStore::read(uint32_t address, backing_store_int_t& value) const
     return true;
 }
 
+bool MockBackingStore::write_bulk(uint32_t address, backing_store_int_t* values, std::size_t item_count) {
+    ++backing_write_bulk_invoke_count;
+
+    // Behaves like the individual writes, but is accounted for as a single operation
+    const std::uint64_t write_invoke_count = backing_write_invoke_count;
+    for (std::size_t i = 0; i < item_count; ++i) {
+        if (!write(address + (i * BACKING_STORE_WRITE_SIZE), values[i])) {
+            backing_write_invoke_count = write_invoke_count;
+            return false;
+        }
+    }
+    backing_write_invoke_count = write_invoke_count;
+    return true;
+}
+
+bool MockBackingStore::read_bulk(uint32_t address, backing_store_int_t* values, std::size_t item_count) const {
+    ++backing_read_bulk_invoke_count;
+
+    if (read_bulk_success_callback && !read_bulk_success_callback(backing_read_bulk_invoke_count, address)) {
+        return false;
+    }
+
+    const std::uint64_t read_invoke_count = backing_read_invoke_count;
+    for (std::size_t i = 0; i < item_count; ++i) {
+        read(address + (i * BACKING_STORE_WRITE_SIZE), values[i]);
+    }
+    backing_read_invoke_count = read_invoke_count;
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Backing Implementation
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -152,3 +211,23 @@ extern "C" bool backing_store_lock(void) {
 extern "C" bool backing_store_read(uint32_t address, backing_store_int_t* value) {
     return MockBackingStore::Instance().read(address, *value);
 }
+
+#ifdef MOCK_BACKING_STORE_BULK
+extern "C" bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, size_t item_count) {
+    return MockBackingStore::Instance().write_bulk(address, values, item_count);
+}
+
+extern "C" bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count) {
+    return MockBackingStore::Instance().read_bulk(address, values, item_count);
+}
+#endif // MOCK_BACKING_STORE_BULK
+
+#ifdef MOCK_BACKING_STORE_ERASE_STEP_SIZE
+extern "C" size_t backing_store_erase_step_count(void) {
+    return WEAR_LEVELING_BACKING_SIZE / MOCK_BACKING_STORE_ERASE_STEP_SIZE;
+}
+
+extern "C" bool backing_store_erase_step(size_t step) {
+    return MockBackingStore::Instance().erase_step(step);
+}
+#endif // MOCK_BACKING_STORE_ERASE_STEP_SIZE
@@ -96,6 +96,12 @@ class MockBackingStore {
     std::uint64_t backing_erase_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
+    std::uint64_t backing_write_bulk_invoke_count;
+    std::uint64_t backing_erase_step_invoke_count;
+
+    // Reads are const, but still counted
+    mutable std::uint64_t backing_read_invoke_count;
+    mutable std::uint64_t backing_read_bulk_invoke_count;
 
     // Whether init should succeed
     std::function<bool(std::uint64_t)> init_success_callback;
@@ -107,6 +113,8 @@ class MockBackingStore {
     std::function<bool(std::uint64_t, std::uint32_t)> write_success_callback;
     // Whether locks should succeed
     std::function<bool(std::uint64_t)> lock_success_callback;
+    // Whether bulk reads should succeed
+    std::function<bool(std::uint64_t, std::uint32_t)> read_bulk_success_callback;
 
     template <typename... Args>
     void append_log(Args&&... args) {
@@ -147,6 +155,18 @@ class MockBackingStore {
     std::uint64_t lock_invoke_count() const {
         return backing_lock_invoke_count;
     }
+    std::uint64_t read_invoke_count() const {
+        return backing_read_invoke_count;
+    }
+    std::uint64_t write_bulk_invoke_count() const {
+        return backing_write_bulk_invoke_count;
+    }
+    std::uint64_t read_bulk_invoke_count() const {
+        return backing_read_bulk_invoke_count;
+    }
+    std::uint64_t erase_step_invoke_count() const {
+        return backing_erase_step_invoke_count;
+    }
 
     // Clear out the internal data for the next run
     void reset_instance();
@@ -159,9 +179,12 @@ class MockBackingStore {
     bool init();
     bool unlock();
     bool erase();
+    bool erase_step(std::size_t step);
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
+    bool write_bulk(std::uint32_t address, backing_store_int_t* values, std::size_t item_count);
+    bool read_bulk(std::uint32_t address, backing_store_int_t* values, std::size_t item_count) const;
 
     // Control over when init/writes/erases should succeed
     void set_init_callback(std::function<bool(std::uint64_t)> callback) {
@@ -179,6 +202,9 @@ class MockBackingStore {
     void set_lock_callback(std::function<bool(std::uint64_t)> callback) {
         lock_success_callback = callback;
     }
+    void set_read_bulk_callback(std::function<bool(std::uint64_t, std::uint32_t)> callback) {
+        read_bulk_success_callback = callback;
+    }
 
     auto storage_begin() const -> decltype(backing_storage.begin()) {
         return backing_storage.begin();
@@ -63,4 +63,46 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+
+wear_leveling_incremental_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=96 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=16 \
+	-DWEAR_LEVELING_BANK_COUNT=2 \
+	-DWEAR_LEVELING_INCREMENTAL_CONSOLIDATION \
+	-DWEAR_LEVELING_CONSOLIDATION_STEP_SIZE=4 \
+	-DMOCK_BACKING_STORE_ERASE_STEP_SIZE=48 \
+	-DBACKING_STORE_ERASE_STEP_SUPPORTED
+wear_leveling_incremental_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_incremental.cpp
+wear_leveling_incremental_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_banked_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=256 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=16 \
+	-DWEAR_LEVELING_BANK_COUNT=4 \
+	-DMOCK_BACKING_STORE_ERASE_STEP_SIZE=32 \
+	-DBACKING_STORE_ERASE_STEP_SUPPORTED
+wear_leveling_banked_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_banked.cpp
+wear_leveling_banked_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_bulk_bench_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DMOCK_BACKING_STORE_BULK \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=8192 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=4096
+wear_leveling_bulk_bench_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_bulk_bench.cpp
+wear_leveling_bulk_bench_INC := \
+	$(wear_leveling_common_INC)
@@ -0,0 +1,124 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+
+class WearLevelingBanked : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        verify_data.fill(0);
+    }
+};
+
+static wear_leveling_status_t test_write(const uint32_t address, const void* value, size_t length) {
+    memcpy(&verify_data[address], value, length);
+    return wear_leveling_write(address, value, length);
+}
+
+// Number of single-byte writes which fill up the write log of a bank
+static constexpr int writes_per_bank = (WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOG_OFFSET) / BACKING_STORE_WRITE_SIZE;
+
+static int write_bytes(int count) {
+    static int counter = 0;
+
+    int consolidations = 0;
+    for (int i = 0; i < count; ++i, ++counter) {
+        // Each byte is a single OPTIMIZED_64 entry, always different to what's already there
+        std::uint8_t           value  = verify_data[counter % WEAR_LEVELING_LOGICAL_SIZE] + 1;
+        wear_leveling_status_t status = test_write(counter % WEAR_LEVELING_LOGICAL_SIZE, &value, sizeof(value));
+        EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+        if (status == WEAR_LEVELING_CONSOLIDATED) {
+            ++consolidations;
+        }
+    }
+    return consolidations;
+}
+
+static void verify_after_reinit(void) {
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Read returned incorrect status";
+    EXPECT_EQ(readback, verify_data) << "Readback doesn't match the written data";
+}
+
+static std::size_t bank_writes(int bank) {
+    auto& inst = MockBackingStore::Instance();
+    return (inst.storage_begin() + (bank * WEAR_LEVELING_BANK_SIZE / BACKING_STORE_WRITE_SIZE))->num_writes();
+}
+
+/**
+ * This test verifies that consecutive consolidations each go into the next bank, wrapping around after the last one.
+ */
+TEST_F(WearLevelingBanked, ConsolidationRotatesThroughBanks) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (int i = 0; i < 2 * WEAR_LEVELING_BANK_COUNT; ++i) {
+        EXPECT_EQ(write_bytes(writes_per_bank), 1) << "Filling the write log should consolidate once";
+        verify_after_reinit();
+    }
+
+    // Every bank has had its consolidated data written once per rotation, without ever erasing the whole backing store
+    for (int bank = 0; bank < WEAR_LEVELING_BANK_COUNT; ++bank) {
+        EXPECT_EQ(bank_writes(bank), 2) << "Bank " << bank << " wasn't consolidated into once per rotation";
+    }
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Backing store shouldn't be erased as a whole";
+    EXPECT_EQ(inst.erase_step_invoke_count(), 2 * WEAR_LEVELING_BACKING_SIZE / MOCK_BACKING_STORE_ERASE_STEP_SIZE) << "Each consolidation should erase a single bank";
+}
+
+/**
+ * This test verifies that initialization reads the bank headers, and only the consolidated data and write log of the newest bank.
+ */
+TEST_F(WearLevelingBanked, InitOnlyReadsNewestBank) {
+    auto& inst = MockBackingStore::Instance();
+    write_bytes(3 * writes_per_bank + writes_per_bank / 2);
+
+    std::uint64_t before = inst.read_invoke_count();
+    verify_after_reinit();
+    std::uint64_t reads = inst.read_invoke_count() - before;
+
+    EXPECT_LE(reads, (WEAR_LEVELING_BANK_COUNT * 8 + WEAR_LEVELING_BANK_SIZE) / BACKING_STORE_WRITE_SIZE) << "Init read more than the headers and a single bank";
+}
+
+/**
+ * This test verifies that a consolidation interrupted before its checksum is written falls back to the previous bank.
+ */
+TEST_F(WearLevelingBanked, InterruptedConsolidationKeepsPreviousBank) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Consolidate into the second bank, then fill up its write log short of the next consolidation
+    EXPECT_EQ(write_bytes(writes_per_bank), 1);
+    EXPECT_EQ(write_bytes(writes_per_bank - 1), 0);
+
+    // Fail the checksum write of the third bank, as if power was lost
+    inst.set_write_callback([](std::uint64_t, std::uint32_t address) { return address != 2 * WEAR_LEVELING_BANK_SIZE + WEAR_LEVELING_LOGICAL_SIZE; });
+    std::uint8_t value = verify_data[0] + 1;
+    EXPECT_EQ(test_write(0, &value, sizeof(value)), WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+    inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+
+    // The second bank still has everything, including the write which triggered the consolidation. Its write log is full, so the third bank is consolidated into again.
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_CONSOLIDATED) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Read returned incorrect status";
+    EXPECT_EQ(readback, verify_data) << "Readback doesn't match the written data";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that erasing the backing store starts over with an empty first bank.
+ */
+TEST_F(WearLevelingBanked, EraseStartsOverInFirstBank) {
+    write_bytes(WEAR_LEVELING_BANK_COUNT * writes_per_bank + 1);
+
+    EXPECT_EQ(wear_leveling_erase(), WEAR_LEVELING_SUCCESS) << "Erase returned incorrect status";
+    verify_data.fill(0);
+    verify_after_reinit();
+
+    EXPECT_EQ(write_bytes(writes_per_bank), 1) << "Filling the write log should consolidate once";
+    verify_after_reinit();
+}
@@ -0,0 +1,124 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <iostream>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+/**
+ * Counts backing store operations, as seen by a driver with bulk read/write support.
+ */
+struct BackingStoreOps {
+    std::uint64_t erases;
+    std::uint64_t writes;
+    std::uint64_t write_bulks;
+    std::uint64_t reads;
+    std::uint64_t read_bulks;
+    std::uint64_t words_written;
+
+    static BackingStoreOps snapshot() {
+        auto& inst = MockBackingStore::Instance();
+        return {inst.erase_invoke_count(), inst.write_invoke_count(), inst.write_bulk_invoke_count(), inst.read_invoke_count(), inst.read_bulk_invoke_count(), inst.total_write_count()};
+    }
+
+    BackingStoreOps operator-(const BackingStoreOps& other) const {
+        return {erases - other.erases, writes - other.writes, write_bulks - other.write_bulks, reads - other.reads, read_bulks - other.read_bulks, words_written - other.words_written};
+    }
+
+    void print(const char* name) const {
+        std::cout << "[  BENCH   ] " << name << ": " << erases << " erase, " << writes << " write, " << write_bulks << " write_bulk (" << words_written << " words), " << reads << " read, " << read_bulks << " read_bulk" << std::endl;
+    }
+};
+
+class WearLevelingBulkBench : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    // Writes changing values until the write log overflows, returning the operations of the write that consolidated
+    BackingStoreOps write_until_consolidated() {
+        for (uint32_t i = 0; i < WEAR_LEVELING_BACKING_SIZE; ++i) {
+            const uint32_t  value  = 0x01010101 * (i & 0xFF) + 0x10000;
+            BackingStoreOps before = BackingStoreOps::snapshot();
+            if (wear_leveling_write((i * 4) % WEAR_LEVELING_LOGICAL_SIZE, &value, sizeof(value)) == WEAR_LEVELING_CONSOLIDATED) {
+                return BackingStoreOps::snapshot() - before;
+            }
+        }
+        ADD_FAILURE() << "Write log never overflowed";
+        return {};
+    }
+};
+
+/**
+ * Consolidation writes out the whole logical area, which should only take a handful of bulk operations.
+ */
+TEST_F(WearLevelingBulkBench, Consolidation) {
+    BackingStoreOps ops = write_until_consolidated();
+    ops.print("consolidation");
+
+    EXPECT_EQ(ops.erases, 1);
+    EXPECT_GE(ops.words_written, (WEAR_LEVELING_LOGICAL_SIZE + 8) / BACKING_STORE_WRITE_SIZE);
+    // Consolidated data and its checksum, plus at most one log entry's worth of single writes
+    EXPECT_LE(ops.write_bulks, 2);
+    EXPECT_LE(ops.writes, sizeof(write_log_entry_t) / BACKING_STORE_WRITE_SIZE);
+}
+
+/**
+ * Playing back a full write log at boot should read it in bulk rather than a word at a time.
+ */
+TEST_F(WearLevelingBulkBench, BootPlayback) {
+    // Fill most of the write log, without overflowing it
+    const uint32_t log_words = (WEAR_LEVELING_BACKING_SIZE - WEAR_LEVELING_LOGICAL_SIZE - 8) / BACKING_STORE_WRITE_SIZE;
+    for (uint32_t i = 0; i < log_words / 8; ++i) {
+        const uint32_t value = 0x01010101 * (i & 0xFF) + 0x10000;
+        ASSERT_EQ(wear_leveling_write((i * 4) % WEAR_LEVELING_LOGICAL_SIZE, &value, sizeof(value)), WEAR_LEVELING_SUCCESS);
+    }
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected;
+    wear_leveling_read(0, expected.data(), expected.size());
+
+    BackingStoreOps before = BackingStoreOps::snapshot();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+    BackingStoreOps ops = BackingStoreOps::snapshot() - before;
+    ops.print("boot playback");
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    wear_leveling_read(0, readback.data(), readback.size());
+    EXPECT_EQ(readback, expected);
+
+    // Consolidated data, its checksum, then the write log a window at a time
+    EXPECT_EQ(ops.reads, 0);
+    EXPECT_LE(ops.read_bulks, 2 + (log_words + WEAR_LEVELING_PLAYBACK_READ_COUNT - 1) / WEAR_LEVELING_PLAYBACK_READ_COUNT);
+}
+
+/**
+ * A failed bulk read of the write log should only fall back to single reads for that window, not be retried for every word in it.
+ */
+TEST_F(WearLevelingBulkBench, BootPlaybackFailedBulkRead) {
+    auto&          inst      = MockBackingStore::Instance();
+    const uint32_t log_words = (WEAR_LEVELING_BACKING_SIZE - WEAR_LEVELING_LOGICAL_SIZE - 8) / BACKING_STORE_WRITE_SIZE;
+    for (uint32_t i = 0; i < log_words / 8; ++i) {
+        const uint32_t value = 0x01010101 * (i & 0xFF) + 0x10000;
+        ASSERT_EQ(wear_leveling_write((i * 4) % WEAR_LEVELING_LOGICAL_SIZE, &value, sizeof(value)), WEAR_LEVELING_SUCCESS);
+    }
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected;
+    wear_leveling_read(0, expected.data(), expected.size());
+
+    // Every bulk read of the write log fails
+    inst.set_read_bulk_callback([](std::uint64_t, std::uint32_t address) { return address < WEAR_LEVELING_LOG_OFFSET; });
+    BackingStoreOps before = BackingStoreOps::snapshot();
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS);
+    BackingStoreOps ops = BackingStoreOps::snapshot() - before;
+    ops.print("boot playback, failed bulk reads");
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    wear_leveling_read(0, readback.data(), readback.size());
+    EXPECT_EQ(readback, expected);
+
+    // One failed bulk read per window, with each word of the write log read on its own once
+    EXPECT_LE(ops.read_bulks, 2 + (log_words + WEAR_LEVELING_PLAYBACK_READ_COUNT - 1) / WEAR_LEVELING_PLAYBACK_READ_COUNT);
+    EXPECT_LE(ops.reads, log_words);
+}
@@ -0,0 +1,192 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingIncremental : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+static std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+
+static wear_leveling_status_t test_write(const uint32_t address, const void* value, size_t length) {
+    memcpy(&verify_data[address], value, length);
+    return wear_leveling_write(address, value, length);
+}
+
+static void fill_write_log(void) {
+    // Each byte is one OPTIMIZED_64 entry, more than the write log can hold
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+    EXPECT_EQ(test_write(0, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+}
+
+static int run_until_consolidated(void) {
+    int calls = 0;
+    for (; calls < 100; ++calls) {
+        if (wear_leveling_task() == WEAR_LEVELING_CONSOLIDATED) {
+            return calls + 1;
+        }
+    }
+    return calls;
+}
+
+static void verify_after_reinit(void) {
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Read returned incorrect status";
+    EXPECT_EQ(readback, verify_data) << "Readback doesn't match the written data";
+}
+
+/**
+ * This test verifies that a full write log isn't consolidated in-line with the write that filled it.
+ */
+TEST_F(WearLevelingIncremental, FullLogDefersConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+    fill_write_log();
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Backing store was erased during the write";
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Read returned incorrect status";
+    EXPECT_EQ(readback, verify_data) << "Cache doesn't hold the written data";
+}
+
+/**
+ * This test verifies that the task consolidates the data a step at a time, and that it can be read back afterwards.
+ */
+TEST_F(WearLevelingIncremental, TaskConsolidatesInSteps) {
+    auto& inst = MockBackingStore::Instance();
+    fill_write_log();
+
+    // One erase step, then the consolidated data one step at a time
+    EXPECT_EQ(run_until_consolidated(), 1 + WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_CONSOLIDATION_STEP_SIZE);
+    EXPECT_EQ(inst.erasure_count(), 1) << "Backing store should have been erased once";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task should be idle once consolidated";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that each task call only writes a bounded amount of data to the backing store.
+ */
+TEST_F(WearLevelingIncremental, TaskWritesAreBounded) {
+    auto& inst = MockBackingStore::Instance();
+    fill_write_log();
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (int i = 0; i < 100 && status != WEAR_LEVELING_CONSOLIDATED; ++i) {
+        std::uint64_t before = inst.total_write_count();
+        status               = wear_leveling_task();
+        // The last step also writes out the checksum, and the bank header if there is one
+        std::uint64_t limit = (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE + (status == WEAR_LEVELING_CONSOLIDATED ? WEAR_LEVELING_LOG_OFFSET - WEAR_LEVELING_LOGICAL_SIZE : 0)) / BACKING_STORE_WRITE_SIZE;
+        EXPECT_LE(inst.total_write_count() - before, limit) << "Too many writes in a single task call";
+    }
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Consolidation never completed";
+}
+
+/**
+ * This test verifies that writes made while the consolidated data is being written out aren't lost.
+ */
+TEST_F(WearLevelingIncremental, WritesDuringConsolidationPersist) {
+    fill_write_log();
+
+    // Erase, then write out the first step of the consolidated data
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+
+    // Modify data that's already been written out, and data that hasn't
+    uint8_t value = 0x99;
+    EXPECT_EQ(test_write(0x01, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    value = 0x77;
+    EXPECT_EQ(test_write(WEAR_LEVELING_LOGICAL_SIZE - 1, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    EXPECT_LT(run_until_consolidated(), 100) << "Consolidation never completed";
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that writes made while the consolidated data is being written out, which won't fit into the fresh write log, start another consolidation.
+ */
+TEST_F(WearLevelingIncremental, LargeWritesDuringConsolidationConsolidateAgain) {
+    auto& inst = MockBackingStore::Instance();
+    fill_write_log();
+
+    // Erase, then write out all but the last step of the consolidated data
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    for (int i = 1; i < WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_CONSOLIDATION_STEP_SIZE; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    }
+
+    // Each byte already written out is one OPTIMIZED_64 entry, more than the fresh write log can hold
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x60);
+    EXPECT_EQ(test_write(0, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (int i = 0; i < 100 && status != WEAR_LEVELING_CONSOLIDATED; ++i) {
+        std::uint64_t before = inst.total_write_count();
+        status               = wear_leveling_task();
+        // Nothing is logged on completion, it would only be cut short by the next consolidation
+        std::uint64_t limit = (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE + (status == WEAR_LEVELING_CONSOLIDATED ? WEAR_LEVELING_LOG_OFFSET - WEAR_LEVELING_LOGICAL_SIZE : 0)) / BACKING_STORE_WRITE_SIZE;
+        EXPECT_LE(inst.total_write_count() - before, limit) << "Too many writes in a single task call";
+    }
+    EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Consolidation never completed";
+
+    EXPECT_LT(run_until_consolidated(), 100) << "Second consolidation never completed";
+    EXPECT_EQ(inst.erasure_count(), 2) << "Backing store should have been erased again";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task should be idle once consolidated";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that writes made while the backing store is being erased aren't lost.
+ */
+TEST_F(WearLevelingIncremental, WritesDuringEraseAreConsolidated) {
+    fill_write_log();
+
+    uint8_t value = 0x55;
+    EXPECT_EQ(test_write(0x03, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+
+    EXPECT_LT(run_until_consolidated(), 100) << "Consolidation never completed";
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that a flush completes any outstanding consolidation.
+ */
+TEST_F(WearLevelingIncremental, FlushCompletesConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+    fill_write_log();
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_CONSOLIDATED) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.erasure_count(), 1) << "Backing store should have been erased once";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush should have nothing left to do";
+
+    verify_after_reinit();
+}
+
+/**
+ * This test verifies that a failed write during consolidation restarts it from the erase.
+ */
+TEST_F(WearLevelingIncremental, FailedWriteRestartsConsolidation) {
+    auto& inst = MockBackingStore::Instance();
+    fill_write_log();
+
+    // Erase, then fail the first write to the consolidated area
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS);
+    inst.set_write_callback([](std::uint64_t, std::uint32_t) { return false; });
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Task returned incorrect status";
+
+    inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+    EXPECT_LT(run_until_consolidated(), 100) << "Consolidation never completed";
+    EXPECT_EQ(inst.erasure_count(), 2) << "Backing store should have been erased again";
+
+    verify_after_reinit();
+}
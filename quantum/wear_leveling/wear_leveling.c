@@ -61,6 +61,11 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_BANK_COUNT: The number of banks the backing store is
+            split into, defaulting to 1. Each bank holds its own consolidated
+            data and write log, and must be erasable on its own through the
+            backing store's erase steps.
+
     General algorithm:
 
         During initialization:
@@ -76,6 +81,42 @@
             * A new write log entry is appended to the log.
             * If the log's full, data is consolidated and the write log cleared.
 
+        With WEAR_LEVELING_INCREMENTAL_CONSOLIDATION, a full log isn't
+        consolidated in-line. Writes then only update the cache, and
+        wear_leveling_task() erases the next bank one step at a time and
+        writes out the cache WEAR_LEVELING_CONSOLIDATION_STEP_SIZE bytes at a
+        time. Writes that land while the cache is being written out are
+        appended to the fresh write log once the checksum is in place. This
+        needs more than one bank, so that the current bank still holds the
+        data while the next one is being filled -- a single bank would leave
+        it only in the cache across many iterations of the main loop.
+
+    Banks:
+
+        With WEAR_LEVELING_BANK_COUNT greater than 1, a full write log is
+        consolidated into the next bank instead of erasing the current one, so
+        consolidations rotate through all of the banks. Only the bank being
+        written to is erased, leaving the previous bank intact until its
+        replacement is complete.
+
+        Each bank's consolidated data acts as a checkpoint: the bank header
+        records a sequence number which is incremented on every
+        consolidation. During initialization the bank headers are used as an
+        index to find the newest bank whose checksum matches, and only that
+        bank's write log is played back. An interrupted consolidation leaves a
+        bank with a mismatched checksum, which is skipped in favour of the
+        previous one.
+
+        Bank structure:
+
+        ╔ Bank ════════════════╦══════════╦══════════╦═══════════╗
+        ║ Consolidated data    ║ FNV1a_64 ║ Header   ║ Write log ║
+        ║ (logical size)       ║ 8 bytes  ║ 8 bytes  ║ ...       ║
+        ╚══════════════════════╩══════════╩══════════╩═══════════╝
+
+        The header holds the 32-bit sequence number followed by its
+        complement, such that an erased header is never considered valid.
+
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
@@ -162,8 +203,35 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#if WEAR_LEVELING_BANK_COUNT > 1
+    uint8_t  bank;     // bank holding the current consolidated data and write log
+    uint32_t sequence; // sequence number of the current bank
+#endif // WEAR_LEVELING_BANK_COUNT > 1
 } wear_leveling;
 
+#if WEAR_LEVELING_BANK_COUNT > 1
+#    define WEAR_LEVELING_CURRENT_BANK (wear_leveling.bank)
+#else
+#    define WEAR_LEVELING_CURRENT_BANK 0
+#endif // WEAR_LEVELING_BANK_COUNT > 1
+#define WEAR_LEVELING_NEXT_BANK ((WEAR_LEVELING_CURRENT_BANK + 1) % (WEAR_LEVELING_BANK_COUNT))
+#define WEAR_LEVELING_BANK_ADDRESS(bank) ((uint32_t)(bank) * (WEAR_LEVELING_BANK_SIZE))
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+typedef enum consolidation_state_t { CONSOLIDATION_IDLE = 0, CONSOLIDATION_ERASING, CONSOLIDATION_WRITING } consolidation_state_t;
+
+/**
+ * Progress of the consolidation being performed by wear_leveling_task().
+ */
+static struct {
+    consolidation_state_t state;
+    uint32_t              position;    // erase step, or offset of the next consolidated data to write
+    uint64_t              checksum;    // FNV1a_64 of the consolidated data written so far
+    uint32_t              dirty_start; // logical range modified after the consolidated data started being written
+    uint32_t              dirty_end;
+} consolidation;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 /**
  * Locking helper: status
  */
@@ -197,14 +265,101 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
     return STATUS_SUCCESS;
 }
 
+/**
+ * Address of the first write log entry in the current bank.
+ */
+static inline uint32_t wear_leveling_log_start(void) {
+    return WEAR_LEVELING_BANK_ADDRESS(WEAR_LEVELING_CURRENT_BANK) + (WEAR_LEVELING_LOG_OFFSET);
+}
+
+/**
+ * Address just past the end of the write log in the current bank.
+ */
+static inline uint32_t wear_leveling_log_end(void) {
+    return WEAR_LEVELING_BANK_ADDRESS(WEAR_LEVELING_CURRENT_BANK + 1);
+}
+
 /**
  * Resets the cache, ensuring the write address is correctly initialised.
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = wear_leveling_log_start();
+}
+
+/**
+ * Reads a single 8-byte entry from the backing store.
+ */
+static bool wear_leveling_read_entry(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_read_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_read_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_read(address, &entry->raw64);
+#endif
 }
 
+/**
+ * Writes a single 8-byte entry to the backing store.
+ */
+static bool wear_leveling_write_entry(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry->raw64);
+#endif
+}
+
+/**
+ * Reads the consolidated data at the start of the given bank into the cache, and verifies it against its FNV1a_64.
+ */
+static wear_leveling_status_t wear_leveling_read_bank(uint8_t bank, bool *valid) {
+    const uint32_t base = WEAR_LEVELING_BANK_ADDRESS(bank);
+
+    *valid = false;
+    if (!backing_store_read_bulk(base, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+        wl_dprintf("Failed to read from backing store\n");
+        return WEAR_LEVELING_FAILED;
+    }
+
+    // Verify the FNV1a_64 result
+    uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+    write_log_entry_t entry;
+    wl_dprintf("Reading checksum\n");
+    wear_leveling_read_entry(base + (WEAR_LEVELING_LOGICAL_SIZE), &entry);
+    *valid = (entry.raw64 == expected);
+    return WEAR_LEVELING_SUCCESS;
+}
+
+#if WEAR_LEVELING_BANK_COUNT > 1
+/**
+ * Finds the bank with the highest sequence number below `limit` in its header.
+ *
+ * @return false if no bank has a valid header below the limit
+ */
+static bool wear_leveling_find_bank(uint32_t limit, uint8_t *bank, uint32_t *sequence) {
+    bool found = false;
+    for (uint8_t i = 0; i < (WEAR_LEVELING_BANK_COUNT); ++i) {
+        write_log_entry_t header;
+        if (!wear_leveling_read_entry(WEAR_LEVELING_BANK_ADDRESS(i) + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &header)) {
+            continue;
+        }
+        if (header.raw32[1] != (uint32_t)~header.raw32[0] || header.raw32[0] >= limit) {
+            continue;
+        }
+        if (!found || header.raw32[0] > *sequence) {
+            *bank     = i;
+            *sequence = header.raw32[0];
+            found     = true;
+        }
+    }
+    return found;
+}
+#endif // WEAR_LEVELING_BANK_COUNT > 1
+
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -213,31 +368,32 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     wl_dprintf("Reading consolidated data\n");
 
     wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
-    if (!backing_store_read_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
-        wl_dprintf("Failed to read from backing store\n");
-        status = WEAR_LEVELING_FAILED;
+    bool                   valid  = false;
+#if WEAR_LEVELING_BANK_COUNT > 1
+    // Start from the newest bank, falling back to older ones if a consolidation into it was interrupted
+    uint32_t limit = UINT32_MAX;
+    while (!valid && status != WEAR_LEVELING_FAILED && wear_leveling_find_bank(limit, &wear_leveling.bank, &wear_leveling.sequence)) {
+        wl_dprintf("Reading bank %d, sequence %lu\n", (int)wear_leveling.bank, (unsigned long)wear_leveling.sequence);
+        status = wear_leveling_read_bank(wear_leveling.bank, &valid);
+        limit  = wear_leveling.sequence;
     }
 
-    // Verify the FNV1a_64 result
-    if (status != WEAR_LEVELING_FAILED) {
-        uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
-        write_log_entry_t entry;
-        wl_dprintf("Reading checksum\n");
-#if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
-#elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
-#elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
-#endif
-        // If we have a mismatch, clear the cache but do not flag a failure,
-        // which will cater for the completely clean MCU case.
-        if (entry.raw64 == expected) {
-            wl_dprintf("Checksum matches, consolidated data is correct\n");
-        } else {
-            wl_dprintf("Checksum mismatch, clearing cache\n");
-            wear_leveling_clear_cache();
-        }
+    // Nothing has been consolidated yet, the write log starts out in the first bank
+    if (!valid) {
+        wear_leveling.bank     = 0;
+        wear_leveling.sequence = 0;
+    }
+#else
+    status = wear_leveling_read_bank(0, &valid);
+#endif // WEAR_LEVELING_BANK_COUNT > 1
+
+    // If we have a mismatch, clear the cache but do not flag a failure,
+    // which will cater for the completely clean MCU case.
+    if (valid) {
+        wl_dprintf("Checksum matches, consolidated data is correct\n");
+    } else if (status != WEAR_LEVELING_FAILED) {
+        wl_dprintf("Checksum mismatch, clearing cache\n");
+        wear_leveling_clear_cache();
     }
 
     // If we failed for any reason, then clear the cache
@@ -249,7 +405,38 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
 }
 
 /**
- * Writes the current cache to consolidated data at the beginning of the backing store.
+ * Writes the FNV1a_64 of the consolidated data after it, along with the bank header, completing the consolidation into the next bank.
+ */
+static bool wear_leveling_write_checksum(uint64_t checksum) {
+    const uint32_t    base = WEAR_LEVELING_BANK_ADDRESS(WEAR_LEVELING_NEXT_BANK);
+    write_log_entry_t entry;
+#if WEAR_LEVELING_BANK_COUNT > 1
+    // The checksum goes last, so that an interrupted consolidation never looks complete
+    entry.raw32[0] = wear_leveling.sequence + 1;
+    entry.raw32[1] = ~entry.raw32[0];
+    wl_dprintf("Writing bank header\n");
+    if (!wear_leveling_write_entry(base + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &entry)) {
+        return false;
+    }
+#endif // WEAR_LEVELING_BANK_COUNT > 1
+    entry.raw64 = checksum;
+    wl_dprintf("Writing checksum\n");
+    return wear_leveling_write_entry(base + (WEAR_LEVELING_LOGICAL_SIZE), &entry);
+}
+
+/**
+ * Makes the bank that was just consolidated into the current one, with an empty write log.
+ */
+static void wear_leveling_switch_bank(void) {
+#if WEAR_LEVELING_BANK_COUNT > 1
+    wear_leveling.bank = WEAR_LEVELING_NEXT_BANK;
+    wear_leveling.sequence++;
+#endif // WEAR_LEVELING_BANK_COUNT > 1
+    wear_leveling.write_address = wear_leveling_log_start();
+}
+
+/**
+ * Writes the current cache to consolidated data at the beginning of the next bank.
  * Does not clear the write log.
  * Pre-condition: this is just after an erase, so we can write directly without reading.
  */
@@ -258,34 +445,16 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
 
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     wear_leveling_status_t      status      = WEAR_LEVELING_CONSOLIDATED;
-    if (!backing_store_write_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+    if (!backing_store_write_bulk(WEAR_LEVELING_BANK_ADDRESS(WEAR_LEVELING_NEXT_BANK), (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to write to backing store\n");
         status = WEAR_LEVELING_FAILED;
     }
 
     if (status != WEAR_LEVELING_FAILED) {
         // Write out the FNV1a_64 result of the consolidated data
-        write_log_entry_t entry;
-        entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
-        wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#endif
-        } while (0);
+        if (!wear_leveling_write_checksum(fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT))) {
+            status = WEAR_LEVELING_FAILED;
+        }
     }
 
     if (lock_status == STATUS_SUCCESS) {
@@ -294,29 +463,63 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
     return status;
 }
 
+#if WEAR_LEVELING_BANK_COUNT > 1
+/**
+ * Number of backing store erase steps covering a single bank, or zero if banks can't be erased on their own.
+ */
+static size_t wear_leveling_bank_erase_steps(void) {
+    const size_t count = backing_store_erase_step_count();
+    return (count % (WEAR_LEVELING_BANK_COUNT)) == 0 ? count / (WEAR_LEVELING_BANK_COUNT) : 0;
+}
+
+/**
+ * Erases the given bank, leaving the others untouched.
+ */
+static bool wear_leveling_erase_bank(uint8_t bank) {
+    const size_t steps = wear_leveling_bank_erase_steps();
+    if (steps == 0) {
+        wl_dprintf("Backing store can't erase a single bank\n");
+        return false;
+    }
+    for (size_t i = 0; i < steps; ++i) {
+        if (!backing_store_erase_step((bank * steps) + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif // WEAR_LEVELING_BANK_COUNT > 1
+
 /**
  * Forces a write of the current cache.
- * Erases the backing store, including the write log.
- * During this operation, there is the potential for data loss if a power loss occurs.
+ * Erases the backing store, including the write log -- with multiple banks, only the next bank is erased.
+ * During this operation, there is the potential for data loss if a power loss occurs, unless multiple banks are used.
  */
 static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+#if WEAR_LEVELING_BANK_COUNT > 1
+    wl_dprintf("Erasing bank %d\n", (int)WEAR_LEVELING_NEXT_BANK);
+
+    // Erase the next bank, the current one is left as-is in case the consolidation is interrupted.
+    bool ok = wear_leveling_erase_bank(WEAR_LEVELING_NEXT_BANK);
+#else
     wl_dprintf("Erasing backing store\n");
 
     // Erase the backing store. Expectation is that any un-written values that are read back after this call come back as zero.
     bool ok = backing_store_erase();
+#endif // WEAR_LEVELING_BANK_COUNT > 1
     if (!ok) {
         wl_dprintf("Failed to erase backing store\n");
         return WEAR_LEVELING_FAILED;
     }
 
-    // Write the cache to the first section of the backing store.
+    // Write the cache to the first section of the bank.
     wear_leveling_status_t status = wear_leveling_write_consolidated();
     if (status == WEAR_LEVELING_FAILED) {
         wl_dprintf("Failed to write consolidated data\n");
     }
 
-    // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    // Next write of the log occurs after the consolidated values at the start of the bank.
+    wear_leveling_switch_bank();
 
     return status;
 }
@@ -329,9 +532,18 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Start as soon as the next log entry might not fit, so that entries are never cut short
+    if (consolidation.state == CONSOLIDATION_IDLE && wear_leveling.write_address + sizeof(write_log_entry_t) > wear_leveling_log_end()) {
+        wl_dprintf("Write log full, deferring consolidation\n");
+        consolidation.state    = CONSOLIDATION_ERASING;
+        consolidation.position = 0;
+    }
+#else
+    if (wear_leveling.write_address >= wear_leveling_log_end()) {
         return wear_leveling_consolidate_force();
     }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
     return WEAR_LEVELING_SUCCESS;
 }
@@ -418,6 +630,12 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     size_t                 remaining = length;
     wear_leveling_status_t status    = WEAR_LEVELING_SUCCESS;
     while (remaining > 0) {
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+        // The rest is in the cache, which is about to be consolidated
+        if (consolidation.state != CONSOLIDATION_IDLE) {
+            break;
+        }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 #if BACKING_STORE_WRITE_SIZE == 2
         // Small-write optimizations - uint16_t, 0 or 1, address is even, address <16384:
         if (remaining >= 2 && address % 2 == 0 && address < 16384) {
@@ -469,18 +687,53 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+/**
+ * Part of the write log read ahead during playback, so that the backing store is read in bulk rather than a word at a time.
+ */
+static struct {
+    uint32_t            address;
+    uint32_t            count;
+    bool                failed; // the bulk read failed, so the words in the window are read one at a time
+    backing_store_int_t values[WEAR_LEVELING_PLAYBACK_READ_COUNT];
+} playback_window;
+
+/**
+ * Reads a word of the write log through the playback window.
+ */
+static bool wear_leveling_playback_read(uint32_t address, backing_store_int_t *value) {
+    if (address < playback_window.address || address >= playback_window.address + playback_window.count * (BACKING_STORE_WRITE_SIZE)) {
+        uint32_t count = (wear_leveling_log_end() - address) / (BACKING_STORE_WRITE_SIZE);
+        if (count > (WEAR_LEVELING_PLAYBACK_READ_COUNT)) {
+            count = (WEAR_LEVELING_PLAYBACK_READ_COUNT);
+        }
+
+        playback_window.address = address;
+        playback_window.count   = count;
+        playback_window.failed  = !backing_store_read_bulk(address, playback_window.values, count);
+    }
+
+    if (playback_window.failed) {
+        // Only part of the window may be unreadable, e.g. ECC errors on a half-written entry, so only fail if this word is
+        return backing_store_read(address, value);
+    }
+
+    *value = playback_window.values[(address - playback_window.address) / (BACKING_STORE_WRITE_SIZE)];
+    return true;
+}
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
 static wear_leveling_status_t wear_leveling_playback_log(void) {
     wl_dprintf("Playback write log\n");
+    playback_window.count = 0;
 
     wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
     bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    uint32_t               address         = wear_leveling_log_start();
+    while (!cancel_playback && address < wear_leveling_log_end()) {
         backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
+        bool                ok = wear_leveling_playback_read(address, &value);
         if (!ok) {
             wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
             cancel_playback = true;
@@ -509,7 +762,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
+                ok = wear_leveling_playback_read(address, &log.raw16[1]);
                 if (!ok) {
                     wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                     cancel_playback = true;
@@ -529,7 +782,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
 #if BACKING_STORE_WRITE_SIZE == 2
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
+                    ok = wear_leveling_playback_read(address, &log.raw16[2]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -539,7 +792,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     address += (BACKING_STORE_WRITE_SIZE);
                 }
                 if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
+                    ok = wear_leveling_playback_read(address, &log.raw16[3]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -550,7 +803,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 }
 #elif BACKING_STORE_WRITE_SIZE == 4
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
+                    ok = wear_leveling_playback_read(address, &log.raw32[1]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -619,6 +872,9 @@ wear_leveling_status_t wear_leveling_init(void) {
 
     // Reset the cache
     wear_leveling_clear_cache();
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    consolidation.state = CONSOLIDATION_IDLE;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
     // Initialise the backing store
     if (!backing_store_init()) {
@@ -661,7 +917,14 @@ wear_leveling_status_t wear_leveling_erase(void) {
 
     // Perform the erase
     bool ret = backing_store_erase();
+#if WEAR_LEVELING_BANK_COUNT > 1
+    wear_leveling.bank     = 0;
+    wear_leveling.sequence = 0;
+#endif // WEAR_LEVELING_BANK_COUNT > 1
     wear_leveling_clear_cache();
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    consolidation.state = CONSOLIDATION_IDLE;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
     // Lock the backing store if we acquired the lock successfully
     if (lock_status == STATUS_SUCCESS) {
@@ -691,6 +954,24 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    if (consolidation.state != CONSOLIDATION_IDLE) {
+        // Nothing to write while the log is being cleared. Anything the consolidated data may have missed is logged once it's done.
+        // Only the part that's already been written out is missed, the rest goes out with the following steps.
+        if (consolidation.state == CONSOLIDATION_WRITING && address < consolidation.position) {
+            const uint32_t end = address + length < consolidation.position ? address + length : consolidation.position;
+            if (consolidation.dirty_start == consolidation.dirty_end) {
+                consolidation.dirty_start = address;
+                consolidation.dirty_end   = end;
+            } else {
+                consolidation.dirty_start = address < consolidation.dirty_start ? address : consolidation.dirty_start;
+                consolidation.dirty_end   = end > consolidation.dirty_end ? end : consolidation.dirty_end;
+            }
+        }
+        return WEAR_LEVELING_SUCCESS;
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -743,6 +1024,135 @@ wear_leveling_status_t wear_leveling_read(const uint32_t address, void *value, s
     return WEAR_LEVELING_SUCCESS;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Logs the writes the consolidated data may have missed into the fresh write log, or starts another consolidation if they might not fit.
+ */
+static wear_leveling_status_t wear_leveling_log_dirty(void) {
+    const uint32_t length = consolidation.dirty_end - consolidation.dirty_start;
+    if (length == 0) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Every logged byte takes at most two bytes of the log, plus a trailing multi-byte entry
+    if (wear_leveling.write_address + (2 * length) + sizeof(write_log_entry_t) > wear_leveling_log_end()) {
+        wl_dprintf("Missed writes don't fit into the write log, consolidating again\n");
+        consolidation.state    = CONSOLIDATION_ERASING;
+        consolidation.position = 0;
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wear_leveling_status_t status = wear_leveling_write_raw(consolidation.dirty_start, &wear_leveling.cache[consolidation.dirty_start], length);
+    if (status == WEAR_LEVELING_SUCCESS) {
+        status = wear_leveling_consolidate_if_needed();
+    }
+    return status;
+}
+
+/**
+ * Performs the next step of a deferred consolidation.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_step(void) {
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    switch (consolidation.state) {
+        case CONSOLIDATION_ERASING:
+            wl_dprintf("Erasing bank %d, step %d\n", (int)WEAR_LEVELING_NEXT_BANK, (int)consolidation.position);
+            // Only the next bank is erased, the current one stays intact until the consolidated data is in place
+            const size_t steps = wear_leveling_bank_erase_steps();
+            if (steps == 0 || !backing_store_erase_step((WEAR_LEVELING_NEXT_BANK * steps) + consolidation.position)) {
+                wl_dprintf("Failed to erase backing store\n");
+                consolidation.position = 0;
+                status                 = WEAR_LEVELING_FAILED;
+                break;
+            }
+            if (++consolidation.position >= steps) {
+                consolidation.state       = CONSOLIDATION_WRITING;
+                consolidation.position    = 0;
+                consolidation.checksum    = FNV1A_64_INIT;
+                consolidation.dirty_start = 0;
+                consolidation.dirty_end   = 0;
+            }
+            break;
+
+        case CONSOLIDATION_WRITING: {
+            const uint32_t remaining = (WEAR_LEVELING_LOGICAL_SIZE)-consolidation.position;
+            const uint32_t length    = remaining >= (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) ? (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) : remaining;
+            uint8_t *      data   = &wear_leveling.cache[consolidation.position];
+
+            wl_dprintf("Writing consolidated data at 0x%04X\n", (int)consolidation.position);
+            consolidation.checksum = fnv_64a_buf(data, length, consolidation.checksum);
+            if (!backing_store_write_bulk(WEAR_LEVELING_BANK_ADDRESS(WEAR_LEVELING_NEXT_BANK) + consolidation.position, (backing_store_int_t *)data, length / sizeof(backing_store_int_t))) {
+                wl_dprintf("Failed to write to backing store\n");
+                status = WEAR_LEVELING_FAILED;
+            } else if ((consolidation.position += length) >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                // The checksum matches what was written, writes since then go into the fresh log
+                if (!wear_leveling_write_checksum(consolidation.checksum)) {
+                    status = WEAR_LEVELING_FAILED;
+                } else {
+                    consolidation.state = CONSOLIDATION_IDLE;
+                    wear_leveling_switch_bank();
+                    status = wear_leveling_log_dirty();
+                    if (status == WEAR_LEVELING_SUCCESS) {
+                        status = WEAR_LEVELING_CONSOLIDATED;
+                    }
+                }
+            }
+
+            if (status == WEAR_LEVELING_FAILED) {
+                // Partially written data can't be written over, start again from the erase -- the cache holds everything
+                consolidation.state    = CONSOLIDATION_ERASING;
+                consolidation.position = 0;
+            }
+        } break;
+
+        default:
+            break;
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+/**
+ * Performs a bounded amount of deferred consolidation work.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    if (consolidation.state != CONSOLIDATION_IDLE) {
+        return wear_leveling_consolidate_step();
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Completes any deferred consolidation.
+ */
+wear_leveling_status_t wear_leveling_flush(void) {
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    while (consolidation.state != CONSOLIDATION_IDLE) {
+        status = wear_leveling_consolidate_step();
+        if (status == WEAR_LEVELING_FAILED) {
+            break;
+        }
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    return status;
+}
+
 /**
  * Weak implementation of bulk read, drivers can implement more optimised implementations.
  */
@@ -766,3 +1176,17 @@ __attribute__((weak)) bool backing_store_write_bulk(uint32_t address, backing_st
     }
     return true;
 }
+
+/**
+ * Weak implementation of stepped erasure, drivers can split the erase into smaller steps, e.g. one per sector.
+ */
+__attribute__((weak)) size_t backing_store_erase_step_count(void) {
+    return 1;
+}
+
+/**
+ * Weak implementation of stepped erasure, erases the whole backing store at once.
+ */
+__attribute__((weak)) bool backing_store_erase_step(size_t step) {
+    return backing_store_erase();
+}
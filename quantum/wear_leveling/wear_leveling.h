@@ -52,3 +52,20 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Performs a bounded amount of deferred consolidation work.
+ *
+ * Only does anything with WEAR_LEVELING_INCREMENTAL_CONSOLIDATION, where a full write log is consolidated a step at a
+ * time from here instead of in-line with the write that filled it.
+ *
+ * @return Status of the request, WEAR_LEVELING_CONSOLIDATED once a deferred consolidation completes
+ */
+wear_leveling_status_t wear_leveling_task(void);
+
+/**
+ * Completes any deferred consolidation, e.g. before the keyboard goes to the bootloader.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_flush(void);
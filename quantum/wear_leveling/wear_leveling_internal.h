@@ -66,6 +66,45 @@ _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
 
+// Number of banks the backing store is split into, each with its own consolidated data and write log
+#ifndef WEAR_LEVELING_BANK_COUNT
+#    define WEAR_LEVELING_BANK_COUNT 1
+#endif
+#define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / (WEAR_LEVELING_BANK_COUNT))
+
+#if WEAR_LEVELING_BANK_COUNT > 1
+// Banks are erased one at a time, which the weak backing_store_erase_step() can't do
+#    ifndef BACKING_STORE_ERASE_STEP_SUPPORTED
+#        error WEAR_LEVELING_BANK_COUNT needs a backing store driver that supports erasing in steps.
+#    endif
+// Each bank's consolidated data is followed by its FNV1a_64 and the bank header
+#    define WEAR_LEVELING_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 16)
+_Static_assert(WEAR_LEVELING_BANK_COUNT <= 255, "Too many wear leveling banks");
+_Static_assert(WEAR_LEVELING_BANK_SIZE * WEAR_LEVELING_BANK_COUNT == WEAR_LEVELING_BACKING_SIZE, "Backing size must be a multiple of the bank count");
+_Static_assert(WEAR_LEVELING_BANK_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Bank size must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_BANK_SIZE >= WEAR_LEVELING_LOG_OFFSET + 8, "Bank size must leave room for the write log");
+#else
+// The consolidated data is followed by its FNV1a_64
+#    define WEAR_LEVELING_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 8)
+#endif
+
+// Number of words of the write log read from the backing store at a time during playback
+#ifndef WEAR_LEVELING_PLAYBACK_READ_COUNT
+#    define WEAR_LEVELING_PLAYBACK_READ_COUNT 16
+#endif
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+// With a single bank the data would only be held in RAM from the erase until the consolidation completes
+#    if WEAR_LEVELING_BANK_COUNT < 2
+#        error WEAR_LEVELING_INCREMENTAL_CONSOLIDATION needs WEAR_LEVELING_BANK_COUNT to be at least 2.
+#    endif
+// Number of bytes of consolidated data written per call to wear_leveling_task()
+#    ifndef WEAR_LEVELING_CONSOLIDATION_STEP_SIZE
+#        define WEAR_LEVELING_CONSOLIDATION_STEP_SIZE 64
+#    endif
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_STEP_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Consolidation step size must be a multiple of write size");
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
 bool backing_store_unlock(void);
@@ -75,6 +114,8 @@ bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, siz
 bool backing_store_lock(void);
 bool backing_store_read(uint32_t address, backing_store_int_t* value);
 bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
+size_t backing_store_erase_step_count(void); // weak implementation already provided, drivers can split erasure into per-sector steps and define BACKING_STORE_ERASE_STEP_SUPPORTED, which is required with multiple banks
+bool backing_store_erase_step(size_t step); // weak implementation already provided, erases everything in a single step
 
 /**
  * Helper type used to contain a write log entry.
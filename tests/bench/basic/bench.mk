@@ -0,0 +1,10 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Features can be toggled from the command line, e.g. `make bench:basic COMBO_ENABLE=no`
+COMBO_ENABLE ?= yes
+TAP_DANCE_ENABLE ?= yes
+KEY_OVERRIDE_ENABLE ?= yes
+AUTOCORRECT_ENABLE ?= yes
+
+INTROSPECTION_KEYMAP_C = bench_keymap.c
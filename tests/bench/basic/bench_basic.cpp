@@ -0,0 +1,55 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "bench_fixture.hpp"
+
+#ifdef TAP_DANCE_ENABLE
+#    define BENCH_TAP_DANCE TD(0)
+#else
+#    define BENCH_TAP_DANCE KC_ESC
+#endif
+
+class BenchBasic : public BenchFixture {
+   public:
+    void SetUp() override {
+        // clang-format off
+        set_keymap({
+            KeymapKey(0, 0, 0, KC_Q), KeymapKey(0, 1, 0, KC_W), KeymapKey(0, 2, 0, KC_E), KeymapKey(0, 3, 0, KC_R), KeymapKey(0, 4, 0, KC_T),
+            KeymapKey(0, 5, 0, KC_Y), KeymapKey(0, 6, 0, KC_U), KeymapKey(0, 7, 0, KC_I), KeymapKey(0, 8, 0, KC_O), KeymapKey(0, 9, 0, KC_P),
+            KeymapKey(0, 0, 1, LCTL_T(KC_A)), KeymapKey(0, 1, 1, KC_S), KeymapKey(0, 2, 1, KC_D), KeymapKey(0, 3, 1, KC_F), KeymapKey(0, 4, 1, KC_G),
+            KeymapKey(0, 5, 1, KC_H), KeymapKey(0, 6, 1, KC_J), KeymapKey(0, 7, 1, KC_K), KeymapKey(0, 8, 1, KC_L), KeymapKey(0, 9, 1, RCTL_T(KC_SCLN)),
+            KeymapKey(0, 0, 2, KC_Z), KeymapKey(0, 1, 2, KC_X), KeymapKey(0, 2, 2, KC_C), KeymapKey(0, 3, 2, KC_V), KeymapKey(0, 4, 2, KC_B),
+            KeymapKey(0, 5, 2, KC_N), KeymapKey(0, 6, 2, KC_M), KeymapKey(0, 7, 2, KC_COMM), KeymapKey(0, 8, 2, KC_DOT), KeymapKey(0, 9, 2, KC_SLSH),
+            KeymapKey(0, 0, 3, KC_LSFT), KeymapKey(0, 1, 3, KC_LGUI), KeymapKey(0, 2, 3, KC_LALT), KeymapKey(0, 3, 3, BENCH_TAP_DANCE), KeymapKey(0, 4, 3, KC_SPC),
+            KeymapKey(0, 5, 3, KC_BSPC), KeymapKey(0, 6, 3, KC_ENT), KeymapKey(0, 7, 3, RSFT_T(KC_TAB)), KeymapKey(0, 8, 3, KC_QUOT), KeymapKey(0, 9, 3, KC_MINS),
+        });
+        // clang-format on
+
+#ifdef AUTOCORRECT_ENABLE
+        autocorrect_enable();
+#endif
+    }
+};
+
+TEST_F(BenchBasic, KeyboardTask) {
+    for (auto &stream : streams()) {
+        bench_keyboard_task(stream);
+    }
+    EXPECT_GT(reports_sent(), 0);
+}
+
+TEST_F(BenchBasic, ActionExec) {
+    for (auto &stream : streams()) {
+        bench_action_exec(stream);
+    }
+    EXPECT_GT(reports_sent(), 0);
+}
+
+TEST_F(BenchBasic, ProcessRecord) {
+    for (auto &stream : streams()) {
+        bench_process_record(stream);
+    }
+    EXPECT_GT(reports_sent(), 0);
+}
@@ -0,0 +1,40 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+#ifdef COMBO_ENABLE
+const uint16_t PROGMEM we_combo[]   = {KC_W, KC_E, COMBO_END};
+const uint16_t PROGMEM io_combo[]   = {KC_I, KC_O, COMBO_END};
+const uint16_t PROGMEM df_combo[]   = {KC_D, KC_F, COMBO_END};
+const uint16_t PROGMEM jk_combo[]   = {KC_J, KC_K, COMBO_END};
+const uint16_t PROGMEM sdf_combo[]  = {KC_S, KC_D, KC_F, COMBO_END};
+const uint16_t PROGMEM xc_combo[]   = {KC_X, KC_C, COMBO_END};
+const uint16_t PROGMEM cd_combo[]   = {KC_COMM, KC_DOT, COMBO_END};
+const uint16_t PROGMEM spbs_combo[] = {KC_SPC, KC_BSPC, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    COMBO(we_combo, KC_LBRC),
+    COMBO(io_combo, KC_RBRC),
+    COMBO(df_combo, KC_TAB),
+    COMBO(jk_combo, KC_ESC),
+    COMBO(sdf_combo, KC_CAPS),
+    COMBO(xc_combo, LCTL(KC_C)),
+    COMBO(cd_combo, KC_EQL),
+    COMBO(spbs_combo, KC_DEL),
+};
+// clang-format on
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+tap_dance_action_t tap_dance_actions[] = {
+    ACTION_TAP_DANCE_DOUBLE(KC_ESC, KC_CAPS),
+};
+#endif
+
+#ifdef KEY_OVERRIDE_ENABLE
+const key_override_t delete_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+
+const key_override_t **key_overrides = (const key_override_t *[]){&delete_key_override, NULL};
+#endif
@@ -0,0 +1,251 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "bench_fixture.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include "test_matrix.h"
+
+extern "C" {
+#include "action.h"
+#include "action_tapping.h"
+#include "host.h"
+#include "keyboard.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+#ifndef BENCH_SETTLE_MS
+/* Scans run after the last event of a stream, so pending tap-hold and combo decisions resolve inside the measurement. */
+#    define BENCH_SETTLE_MS (TAPPING_TERM * 2)
+#endif
+
+namespace {
+std::vector<KeyStream>   recorded;
+std::vector<BenchResult> collected;
+uint32_t                 report_count;
+
+uint8_t bench_keyboard_leds(void) {
+    return 0;
+}
+
+void bench_send_keyboard(report_keyboard_t *report) {
+    report_count++;
+}
+
+void bench_send_nkro(report_nkro_t *report) {
+    report_count++;
+}
+
+void bench_send_mouse(report_mouse_t *report) {
+    report_count++;
+}
+
+void bench_send_extra(report_extra_t *report) {
+    report_count++;
+}
+
+host_driver_t bench_driver = {bench_keyboard_leds, bench_send_keyboard, bench_send_nkro, bench_send_mouse, bench_send_extra};
+
+/* MAKE_EVENT() uses designated initializers in an order C++ doesn't accept */
+keyevent_t make_event(uint8_t row, uint8_t col, bool pressed, keyevent_type_t type) {
+    return {.key = {.col = col, .row = row}, .time = timer_read(), .type = type, .pressed = pressed};
+}
+
+template <typename F>
+inline void timed(BenchStats *stats, F &&call) {
+    if (!stats) {
+        call();
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    call();
+    const uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    stats->ops++;
+    stats->total_ns += elapsed;
+    if (elapsed > stats->max_ns) {
+        stats->max_ns = elapsed;
+    }
+}
+
+void write_json_string(std::ostream &out, const std::string &value) {
+    out << '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out << '\\';
+        }
+        out << c;
+    }
+    out << '"';
+}
+} // namespace
+
+BenchFixture::BenchFixture() {
+    host_set_driver(&bench_driver);
+    report_count = 0;
+}
+
+BenchFixture::~BenchFixture() {
+    // Flush pending state while reports still go to the counting driver
+    clear_all_keys();
+    idle_for(TAPPING_TERM * 10);
+}
+
+std::vector<KeyStream> &BenchFixture::recorded_streams() {
+    return recorded;
+}
+
+const std::vector<BenchResult> &BenchFixture::results() {
+    return collected;
+}
+
+uint32_t BenchFixture::reports_sent() const {
+    return report_count;
+}
+
+std::vector<KeyStream> BenchFixture::streams() const {
+    std::vector<keypos_t> keys;
+    for (auto &key : keymap) {
+        if (key.layer == 0) {
+            keys.push_back(key.position);
+        }
+    }
+
+    std::vector<KeyStream> result = {
+        make_synthetic_key_stream("synthetic_typing", keys, {.strokes = 500, .interval_ms = 120, .hold_ms = 90, .chord_size = 1, .seed = 1}),
+        make_synthetic_key_stream("synthetic_burst", keys, {.strokes = 500, .interval_ms = 25, .hold_ms = 60, .chord_size = 1, .seed = 2}),
+        make_synthetic_key_stream("synthetic_chords", keys, {.strokes = 250, .interval_ms = 150, .hold_ms = 70, .chord_size = 2, .seed = 3}),
+    };
+    result.insert(result.end(), recorded.begin(), recorded.end());
+
+    return result;
+}
+
+void BenchFixture::replay_keyboard_task(const KeyStream &stream, BenchStats *stats) {
+    uint32_t elapsed = 0;
+
+    for (auto &event : stream.events) {
+        for (; elapsed < event.time; elapsed++) {
+            timed(stats, keyboard_task);
+            advance_time(1);
+        }
+
+        if (event.pressed) {
+            press_key(event.col, event.row);
+        } else {
+            release_key(event.col, event.row);
+        }
+    }
+
+    for (unsigned i = 0; i < BENCH_SETTLE_MS; i++) {
+        timed(stats, keyboard_task);
+        advance_time(1);
+    }
+}
+
+void BenchFixture::replay_action_exec(const KeyStream &stream, BenchStats *stats) {
+    uint32_t elapsed = 0;
+
+    for (auto &event : stream.events) {
+        for (; elapsed < event.time; elapsed++) {
+            timed(stats, [] { action_exec(make_event(0, 0, false, TICK_EVENT)); });
+            advance_time(1);
+        }
+
+        timed(stats, [&] { action_exec(make_event(event.row, event.col, event.pressed, KEY_EVENT)); });
+    }
+
+    for (unsigned i = 0; i < BENCH_SETTLE_MS; i++) {
+        timed(stats, [] { action_exec(make_event(0, 0, false, TICK_EVENT)); });
+        advance_time(1);
+    }
+}
+
+void BenchFixture::replay_process_record(const KeyStream &stream, BenchStats *stats) {
+    uint32_t elapsed = 0;
+
+    for (auto &event : stream.events) {
+        advance_time(event.time - elapsed);
+        elapsed = event.time;
+
+        keyrecord_t record = {};
+        record.event       = make_event(event.row, event.col, event.pressed, KEY_EVENT);
+        timed(stats, [&] { process_record(&record); });
+    }
+
+    advance_time(BENCH_SETTLE_MS);
+}
+
+void BenchFixture::record(const char *benchmark, const KeyStream &stream, void (BenchFixture::*replay)(const KeyStream &, BenchStats *)) {
+    BenchResult result{benchmark, stream.name, {}};
+
+    (this->*replay)(stream, nullptr);
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        (this->*replay)(stream, &result.stats);
+    }
+
+    collected.push_back(result);
+}
+
+void BenchFixture::bench_keyboard_task(const KeyStream &stream) {
+    record("keyboard_task", stream, &BenchFixture::replay_keyboard_task);
+}
+
+void BenchFixture::bench_action_exec(const KeyStream &stream) {
+    record("action_exec", stream, &BenchFixture::replay_action_exec);
+}
+
+void BenchFixture::bench_process_record(const KeyStream &stream) {
+    record("process_record", stream, &BenchFixture::replay_process_record);
+}
+
+void BenchFixture::write_json(std::ostream &out) {
+    const char *features[] = {
+#ifdef COMBO_ENABLE
+        "combo",
+#endif
+#ifdef TAP_DANCE_ENABLE
+        "tap_dance",
+#endif
+#ifdef KEY_OVERRIDE_ENABLE
+        "key_override",
+#endif
+#ifdef AUTOCORRECT_ENABLE
+        "autocorrect",
+#endif
+        nullptr,
+    };
+
+    out << "{\n";
+    out << "    \"suite\": ";
+    write_json_string(out, BENCH_SUITE);
+    out << ",\n";
+    out << "    \"iterations\": " << BENCH_ITERATIONS << ",\n";
+
+    out << "    \"features\": [";
+    for (size_t i = 0; features[i]; i++) {
+        out << (i ? ", " : "");
+        write_json_string(out, features[i]);
+    }
+    out << "],\n";
+
+    out << "    \"results\": [";
+    for (size_t i = 0; i < collected.size(); i++) {
+        const BenchResult &result    = collected[i];
+        const double       ns_per_op = result.stats.ops ? (double)result.stats.total_ns / result.stats.ops : 0;
+
+        out << (i ? ",\n" : "\n") << "        {\"benchmark\": ";
+        write_json_string(out, result.benchmark);
+        out << ", \"stream\": ";
+        write_json_string(out, result.stream);
+        out << ", \"ops\": " << result.stats.ops;
+        out << ", \"ns_per_op\": " << std::fixed << std::setprecision(1) << ns_per_op;
+        out << ", \"max_ns\": " << result.stats.max_ns << "}";
+    }
+    out << "\n    ]\n";
+    out << "}\n";
+}
@@ -0,0 +1,76 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "test_fixture.hpp"
+#include "key_stream.hpp"
+
+#ifndef BENCH_ITERATIONS
+#    define BENCH_ITERATIONS 5
+#endif
+
+struct BenchStats {
+    uint64_t ops      = 0;
+    uint64_t total_ns = 0;
+    uint64_t max_ns   = 0;
+};
+
+struct BenchResult {
+    std::string benchmark;
+    std::string stream;
+    BenchStats  stats;
+};
+
+/**
+ * @brief TestFixture that replays key streams through the keycode pipeline and
+ * times the entry points it is fed through.
+ *
+ * Reports are swallowed by a counting host driver instead of the gmock based
+ * TestDriver, so that mock bookkeeping doesn't end up in the measurements.
+ * Every stream is replayed once as warm-up and then BENCH_ITERATIONS times.
+ */
+class BenchFixture : public TestFixture {
+   public:
+    BenchFixture();
+    ~BenchFixture();
+
+    /* Recorded streams, loaded by the benchmark main from --stream arguments. */
+    static std::vector<KeyStream>& recorded_streams();
+    static const std::vector<BenchResult>& results();
+    static void                            write_json(std::ostream& out);
+
+    /**
+     * @brief Synthetic typing, burst and chord streams over every key on layer 0
+     * followed by all recorded streams.
+     */
+    std::vector<KeyStream> streams() const;
+
+    /**
+     * @brief Replays `stream` through keyboard_task(), one scan per millisecond.
+     */
+    void bench_keyboard_task(const KeyStream& stream);
+
+    /**
+     * @brief Feeds `stream` into action_exec(), with a tick event for every
+     * millisecond in between, like keyboard_task() would.
+     */
+    void bench_action_exec(const KeyStream& stream);
+
+    /**
+     * @brief Feeds `stream` straight into process_record(), bypassing tapping.
+     */
+    void bench_process_record(const KeyStream& stream);
+
+    uint32_t reports_sent() const;
+
+   private:
+    void replay_keyboard_task(const KeyStream& stream, BenchStats* stats);
+    void replay_action_exec(const KeyStream& stream, BenchStats* stats);
+    void replay_process_record(const KeyStream& stream, BenchStats* stats);
+    void record(const char* benchmark, const KeyStream& stream, void (BenchFixture::*replay)(const KeyStream&, BenchStats*));
+};
@@ -0,0 +1,65 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "bench_fixture.hpp"
+
+extern "C" {
+#include "stdio.h"
+#include "debug.h"
+
+int8_t sendchar(uint8_t c) {
+    fprintf(stdout, "%c", c);
+    return 0;
+}
+
+__attribute__((weak)) debug_config_t debug_config = {0};
+}
+
+/* Usage: bench_<suite>.elf [gtest flags] [--json=<path>] [--stream=<recording>]... */
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+
+    print_set_sendchar(sendchar);
+
+    const char *json_path = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--json=", 7) == 0) {
+            json_path = argv[i] + 7;
+        } else if (strncmp(argv[i], "--stream=", 9) == 0) {
+            KeyStream   stream;
+            std::string error;
+            if (!load_key_stream(argv[i] + 9, stream, error)) {
+                std::cerr << error << std::endl;
+                return 1;
+            }
+            BenchFixture::recorded_streams().push_back(stream);
+        } else {
+            std::cerr << "unknown argument " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    const int result = RUN_ALL_TESTS();
+    if (result != 0) {
+        return result;
+    }
+
+    if (json_path) {
+        std::ofstream file(json_path);
+        BenchFixture::write_json(file);
+        if (!file) {
+            std::cerr << "can't write " << json_path << std::endl;
+            return 1;
+        }
+    } else {
+        BenchFixture::write_json(std::cout);
+    }
+
+    return 0;
+}
@@ -0,0 +1,11 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+$(TEST_OUTPUT)_SRC += \
+	tests/bench/bench_common/bench_main.cpp \
+	tests/bench/bench_common/bench_fixture.cpp \
+	tests/bench/bench_common/key_stream.cpp
+
+$(TEST_OUTPUT)_DEFS += "-DBENCH_SUITE=\"$(TEST)\""
+
+VPATH += $(TOP_DIR)/tests/bench/bench_common
@@ -0,0 +1,98 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "key_stream.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+
+KeyStream make_synthetic_key_stream(const std::string& name, const std::vector<keypos_t>& keys, const SyntheticKeyStreamConfig& config) {
+    KeyStream stream{name, {}};
+
+    std::mt19937                          rng(config.seed);
+    std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+    std::vector<uint32_t>                 released_at(keys.size(), 0);
+
+    uint32_t time = 1;
+    for (size_t stroke = 0; stroke < config.strokes; stroke++, time += config.interval_ms) {
+        std::vector<size_t> chord;
+
+        for (uint8_t i = 0; i < config.chord_size && chord.size() < keys.size(); i++) {
+            // Walk to the next key that is neither held nor already part of this chord
+            size_t index = pick(rng);
+            for (size_t tries = 0; tries < keys.size(); tries++, index = (index + 1) % keys.size()) {
+                if (released_at[index] < time && std::find(chord.begin(), chord.end(), index) == chord.end()) {
+                    chord.push_back(index);
+                    break;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < chord.size(); i++) {
+            const keypos_t key     = keys[chord[i]];
+            const uint32_t press   = time + i;
+            const uint32_t release = press + config.hold_ms;
+
+            stream.events.push_back({press, key.row, key.col, true});
+            stream.events.push_back({release, key.row, key.col, false});
+            released_at[chord[i]] = release;
+        }
+    }
+
+    std::stable_sort(stream.events.begin(), stream.events.end(), [](const KeyStreamEvent& a, const KeyStreamEvent& b) { return a.time < b.time; });
+
+    return stream;
+}
+
+bool load_key_stream(const std::string& path, KeyStream& stream, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "can't open " + path;
+        return false;
+    }
+
+    stream.name = path.substr(path.find_last_of('/') + 1);
+    stream.events.clear();
+
+    std::map<std::pair<uint8_t, uint8_t>, bool> pressed;
+    uint32_t                                    previous_time = 0;
+    std::string                                 line;
+
+    for (unsigned line_number = 1; std::getline(file, line); line_number++) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        uint32_t           time;
+        unsigned           row, col;
+        char               direction;
+
+        if (!(fields >> time >> row >> col >> direction) || (direction != 'd' && direction != 'u') || row >= MATRIX_ROWS || col >= MATRIX_COLS || time < previous_time) {
+            error = path + ":" + std::to_string(line_number) + ": invalid event '" + line + "'";
+            return false;
+        }
+
+        bool& is_pressed = pressed[{row, col}];
+        if (is_pressed == (direction == 'd')) {
+            error = path + ":" + std::to_string(line_number) + ": key " + std::to_string(row) + "," + std::to_string(col) + " is already " + (is_pressed ? "down" : "up");
+            return false;
+        }
+        is_pressed = !is_pressed;
+
+        stream.events.push_back({time, (uint8_t)row, (uint8_t)col, is_pressed});
+        previous_time = time;
+    }
+
+    for (auto& key : pressed) {
+        if (key.second) {
+            error = path + ": key " + std::to_string(key.first.first) + "," + std::to_string(key.first.second) + " is never released";
+            return false;
+        }
+    }
+
+    return true;
+}
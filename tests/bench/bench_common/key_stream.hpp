@@ -0,0 +1,49 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "keyboard.h"
+}
+
+struct KeyStreamEvent {
+    uint32_t time; /* milliseconds since the start of the stream */
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+struct KeyStream {
+    std::string                 name;
+    std::vector<KeyStreamEvent> events;
+};
+
+struct SyntheticKeyStreamConfig {
+    size_t   strokes;     /* number of key presses, chords count once */
+    unsigned interval_ms; /* time between consecutive strokes */
+    unsigned hold_ms;     /* time each key is held, longer than interval_ms rolls over */
+    uint8_t  chord_size;  /* keys pressed together per stroke */
+    uint32_t seed;
+};
+
+/**
+ * @brief Generates a reproducible stream of random strokes over `keys`.
+ *
+ * A key is never pressed again while it is still held, so every press has a
+ * matching release and the stream ends with all keys released.
+ */
+KeyStream make_synthetic_key_stream(const std::string& name, const std::vector<keypos_t>& keys, const SyntheticKeyStreamConfig& config);
+
+/**
+ * @brief Loads a recorded stream, one `<time_ms> <row> <col> <d|u>` event per line.
+ *
+ * Empty lines and lines starting with `#` are ignored.
+ *
+ * @return false if the file can't be read or contains an invalid event
+ */
+bool load_key_stream(const std::string& path, KeyStream& stream, std::string& error);
@@ -6,3 +6,5 @@
 #include "test_common.h"
 
 #define TAPPING_TERM 200
+
+#define COMBO_INDEX_LENGTH 16
@@ -4,14 +4,20 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 #include "quantum.h"
 
-enum combos { modtest, osmshift };
+enum combos { modtest, osmshift, shared_esc, shared_tab, superset_enter };
 
-uint16_t const modtest_combo[]  = {KC_Y, KC_U, COMBO_END};
-uint16_t const osmshift_combo[] = {KC_Z, KC_X, COMBO_END};
+uint16_t const modtest_combo[]    = {KC_Y, KC_U, COMBO_END};
+uint16_t const osmshift_combo[]   = {KC_Z, KC_X, COMBO_END};
+uint16_t const shared_esc_combo[] = {KC_A, KC_B, COMBO_END};
+uint16_t const shared_tab_combo[] = {KC_A, KC_C, COMBO_END};
+uint16_t const superset_combo[]   = {KC_A, KC_B, KC_C, COMBO_END};
 
 // clang-format off
 combo_t key_combos[] = {
-    [modtest]  = COMBO(modtest_combo, RSFT_T(KC_SPACE)),
-    [osmshift] = COMBO(osmshift_combo, OSM(MOD_LSFT))
+    [modtest]        = COMBO(modtest_combo, RSFT_T(KC_SPACE)),
+    [osmshift]       = COMBO(osmshift_combo, OSM(MOD_LSFT)),
+    [shared_esc]     = COMBO(shared_esc_combo, KC_ESC),
+    [shared_tab]     = COMBO(shared_tab_combo, KC_TAB),
+    [superset_enter] = COMBO(superset_combo, KC_ENTER)
 };
 // clang-format on
@@ -0,0 +1,127 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+
+void suspend_power_down_quantum(void);
+void shutdown_quantum(bool jump_to_bootloader);
+}
+
+using testing::_;
+
+class DynamicKeymap : public TestFixture {
+   public:
+    DynamicKeymap() {
+        dynamic_keymap_flush();
+        dynamic_keymap_reload();
+    }
+
+    // What is stored in EEPROM for a key, bypassing the mirror
+    static uint16_t stored_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+        uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        return eeprom_read_byte(address) << 8 | eeprom_read_byte(address + 1);
+    }
+
+    static void store_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
+        uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        eeprom_update_byte(address, keycode >> 8);
+        eeprom_update_byte(address + 1, keycode & 0xFF);
+    }
+};
+
+TEST_F(DynamicKeymap, LoadsMirrorFromEeprom) {
+    store_keycode(0, 0, 0, KC_B);
+    store_keycode(1, 1, 1, KC_C);
+    dynamic_keymap_reload();
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 1, 1), KC_C);
+
+    // Once loaded, lookups are served from RAM
+    store_keycode(0, 0, 0, KC_D);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_B);
+}
+
+TEST_F(DynamicKeymap, WritesBackAfterFlushTimeout) {
+    TestDriver driver;
+
+    store_keycode(0, 0, 0, KC_A);
+    dynamic_keymap_reload();
+
+    dynamic_keymap_set_keycode(0, 0, 0, KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_B);
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_A);
+
+    idle_for(DYNAMIC_KEYMAP_FLUSH_TIMEOUT / 2);
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_A);
+
+    // Another write restarts the timeout
+    dynamic_keymap_set_keycode(0, 0, 1, KC_C);
+    idle_for(DYNAMIC_KEYMAP_FLUSH_TIMEOUT / 2 + 1);
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_A);
+    EXPECT_NE(stored_keycode(0, 0, 1), KC_C);
+
+    idle_for(DYNAMIC_KEYMAP_FLUSH_TIMEOUT / 2);
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_B);
+    EXPECT_EQ(stored_keycode(0, 0, 1), KC_C);
+}
+
+TEST_F(DynamicKeymap, MergesDirtyRangesIntoOneWrite) {
+    store_keycode(0, 0, 0, KC_A);
+    store_keycode(0, 0, 1, KC_B);
+    store_keycode(0, 0, 2, KC_C);
+    dynamic_keymap_reload();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_B);
+
+    // Change the key in between behind the mirror's back: writing back the
+    // merged range restores it, the ends alone would leave it alone.
+    store_keycode(0, 0, 1, KC_X);
+
+    dynamic_keymap_set_keycode(0, 0, 2, KC_F);
+    dynamic_keymap_set_keycode(0, 0, 0, KC_D);
+    dynamic_keymap_flush();
+
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_D);
+    EXPECT_EQ(stored_keycode(0, 0, 1), KC_B);
+    EXPECT_EQ(stored_keycode(0, 0, 2), KC_F);
+}
+
+TEST_F(DynamicKeymap, UnchangedWritesAreNotDirty) {
+    store_keycode(0, 0, 0, KC_A);
+    dynamic_keymap_reload();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+
+    store_keycode(0, 0, 0, KC_X);
+    dynamic_keymap_set_keycode(0, 0, 0, KC_A);
+    dynamic_keymap_flush();
+
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_X);
+}
+
+TEST_F(DynamicKeymap, FlushesOnSuspend) {
+    store_keycode(0, 0, 0, KC_A);
+    dynamic_keymap_reload();
+
+    dynamic_keymap_set_keycode(0, 0, 0, KC_B);
+    suspend_power_down_quantum();
+
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_B);
+}
+
+TEST_F(DynamicKeymap, FlushesOnShutdown) {
+    TestDriver driver;
+
+    store_keycode(0, 0, 0, KC_A);
+    dynamic_keymap_reload();
+
+    dynamic_keymap_set_keycode(0, 0, 0, KC_B);
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+    shutdown_quantum(false);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_B);
+}
@@ -0,0 +1,156 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "keycode_cache.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class KeycodeCache : public TestFixture {};
+
+TEST_F(KeycodeCache, resolves_transparent_keys_to_lower_layers) {
+    TestDriver driver;
+    InSequence s;
+    auto       layer_key   = KeymapKey(0, 0, 0, MO(1));
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+    auto       layer_1_key = KeymapKey(1, 1, 0, KC_TRNS);
+
+    set_keymap({layer_key, regular_key, layer_1_key, KeymapKey(1, 0, 0, KC_TRNS)});
+
+    EXPECT_EQ(keycode_cache_get_layer(regular_key.position), 0);
+
+    layer_key.press();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(keycode_cache_get_layer(regular_key.position), 0);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    layer_key.release();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeycodeCache, follows_momentary_layer_changes) {
+    TestDriver driver;
+    InSequence s;
+    auto       layer_key   = KeymapKey(0, 0, 0, MO(1));
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+    auto       layer_1_key = KeymapKey(1, 1, 0, KC_B);
+
+    set_keymap({layer_key, regular_key, layer_1_key, KeymapKey(1, 0, 0, KC_TRNS)});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    layer_key.press();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(keycode_cache_get_layer(regular_key.position), 1);
+    EXPECT_EQ(keycode_cache_get_keycode(1, regular_key.position), KC_B);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    layer_key.release();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(keycode_cache_get_layer(regular_key.position), 0);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeycodeCache, follows_default_layer_changes) {
+    TestDriver driver;
+    InSequence s;
+    auto       regular_key = KeymapKey(0, 1, 0, KC_A);
+    auto       layer_2_key = KeymapKey(2, 1, 0, KC_C);
+
+    set_keymap({regular_key, layer_2_key});
+
+    const layer_state_t default_layers = default_layer_state;
+    EXPECT_EQ(keycode_cache_get_layer(regular_key.position), 0);
+
+    default_layer_set((layer_state_t)1 << 2);
+    EXPECT_EQ(keycode_cache_get_layer(regular_key.position), 2);
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+
+    default_layer_set(default_layers);
+    EXPECT_EQ(keycode_cache_get_layer(regular_key.position), 0);
+}
+
+TEST_F(KeycodeCache, follows_layer_state_written_directly) {
+    auto regular_key = KeymapKey(0, 1, 0, KC_A);
+    auto layer_3_key = KeymapKey(3, 1, 0, KC_D);
+
+    set_keymap({regular_key, layer_3_key});
+
+    EXPECT_EQ(keycode_cache_get_keycode(0, regular_key.position), KC_A);
+
+    layer_state = (layer_state_t)1 << 3;
+    EXPECT_EQ(keycode_cache_get_layer(regular_key.position), 3);
+    EXPECT_EQ(keycode_cache_get_keycode(3, regular_key.position), KC_D);
+
+    layer_state = 0;
+    EXPECT_EQ(keycode_cache_get_layer(regular_key.position), 0);
+}
+
+TEST_F(KeycodeCache, keeps_lower_layers_when_higher_transparent_layer_turns_on) {
+    auto regular_key = KeymapKey(0, 1, 0, KC_A);
+    auto other_key   = KeymapKey(0, 2, 0, KC_B);
+    auto layer_1_key = KeymapKey(1, 2, 0, KC_E);
+
+    set_keymap({regular_key, other_key, layer_1_key, KeymapKey(1, 1, 0, KC_TRNS)});
+
+    EXPECT_EQ(keycode_cache_get_layer(regular_key.position), 0);
+    EXPECT_EQ(keycode_cache_get_layer(other_key.position), 0);
+
+    layer_on(1);
+    EXPECT_EQ(keycode_cache_get_layer(regular_key.position), 0);
+    EXPECT_EQ(keycode_cache_get_keycode(0, regular_key.position), KC_A);
+    EXPECT_EQ(keycode_cache_get_layer(other_key.position), 1);
+    EXPECT_EQ(keycode_cache_get_keycode(1, other_key.position), KC_E);
+
+    layer_off(1);
+    EXPECT_EQ(keycode_cache_get_layer(other_key.position), 0);
+    EXPECT_EQ(keycode_cache_get_keycode(0, other_key.position), KC_B);
+}
+
+TEST_F(KeycodeCache, reads_uncached_layers_from_keymap) {
+    auto regular_key = KeymapKey(0, 1, 0, KC_A);
+    auto layer_1_key = KeymapKey(1, 1, 0, KC_F);
+
+    set_keymap({regular_key, layer_1_key});
+
+    EXPECT_EQ(keycode_cache_get_layer(regular_key.position), 0);
+    EXPECT_EQ(keycode_cache_get_keycode(1, regular_key.position), KC_F);
+}
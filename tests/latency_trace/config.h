@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Long enough for a mod-tap resolving as held after the default TAPPING_TERM to still count
+#define LATENCY_TRACE_REPORT_TIMEOUT 250
@@ -0,0 +1,99 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "latency_trace.h"
+}
+
+using testing::_;
+
+class LatencyTrace : public TestFixture {
+   public:
+    LatencyTrace() {
+        latency_trace_reset();
+    }
+
+    latency_trace_stats_t scan_to_report() {
+        latency_trace_stats_t stats;
+        latency_trace_task();
+        latency_trace_get_stats(LATENCY_TRACE_SCAN_TO_REPORT, &stats);
+        return stats;
+    }
+};
+
+TEST_F(LatencyTrace, ReportInSameScanAsChange) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_trace_stats_t stats = scan_to_report();
+    EXPECT_EQ(stats.count, 2);
+    EXPECT_EQ(stats.max, 0);
+    EXPECT_EQ(latency_trace_unmatched(), 0);
+}
+
+TEST_F(LatencyTrace, HeldModTapMeasuredFromPress) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    latency_trace_stats_t stats = scan_to_report();
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.max, TAPPING_TERM);
+
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTrace, TappedModTapMeasuredFromRelease) {
+    TestDriver driver;
+    auto       mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+
+    set_keymap({mod_tap_key});
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    idle_for(TAPPING_TERM / 2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The press was overtaken by the release before anything was sent
+    latency_trace_stats_t stats = scan_to_report();
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.max, 0);
+    EXPECT_EQ(latency_trace_unmatched(), 1);
+}
+
+TEST_F(LatencyTrace, LabelledWithDebounceType) {
+    EXPECT_STREQ(latency_trace_debounce_type(), "sym_defer_g");
+}
@@ -224,3 +224,52 @@ TEST_F(DefaultTapHold, tap_and_hold_mod_tap_hold_key) {
     run_one_scan_loop();
     VERIFY_AND_CLEAR(driver);
 }
+
+TEST_F(DefaultTapHold, tap_regular_keys_overflowing_waiting_buffer_while_mod_tap_key_is_held) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    auto       key_a            = KeymapKey(0, 1, 0, KC_A);
+    auto       key_b            = KeymapKey(0, 2, 0, KC_B);
+    auto       key_c            = KeymapKey(0, 3, 0, KC_C);
+    auto       key_d            = KeymapKey(0, 4, 0, KC_D);
+
+    set_keymap({mod_tap_hold_key, key_a, key_b, key_c, key_d});
+
+    const uint16_t overflows = get_waiting_buffer_overflows();
+
+    /* Press mod-tap-hold key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Tap regular keys until the waiting buffer is full. */
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_a, key_b, key_c);
+    key_d.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Release the last regular key, which doesn't fit in the waiting buffer
+     * anymore: the mod-tap-hold key is settled as held instead of dropping keys. */
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_C));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_D));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    key_d.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(get_waiting_buffer_overflows(), overflows + 1);
+
+    /* Release mod-tap-hold key. */
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
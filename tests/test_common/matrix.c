@@ -26,6 +26,7 @@ void matrix_init(void) {
 }
 
 uint8_t matrix_scan(void) {
+    matrix_dirty_rows_begin(0);
     matrix_scan_kb();
     return 1;
 }
@@ -42,10 +43,12 @@ void matrix_scan_kb(void) {}
 
 void press_key(uint8_t col, uint8_t row) {
     matrix[row] |= (matrix_row_t)1 << col;
+    matrix_set_row_dirty(row);
 }
 
 void release_key(uint8_t col, uint8_t row) {
     matrix[row] &= ~((matrix_row_t)1 << col);
+    matrix_set_row_dirty(row);
 }
 
 bool matrix_is_on(uint8_t row, uint8_t col) {
@@ -54,6 +57,9 @@ bool matrix_is_on(uint8_t row, uint8_t col) {
 
 void clear_all_keys(void) {
     memset(matrix, 0, sizeof(matrix));
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_set_row_dirty(row);
+    }
 }
 
 void led_set(uint8_t usb_led) {}
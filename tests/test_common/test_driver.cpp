@@ -16,6 +16,12 @@
 
 #include "test_driver.hpp"
 
+#ifdef LATENCY_TRACE_ENABLE
+extern "C" {
+#    include "latency_trace.h"
+}
+#endif
+
 TestDriver* TestDriver::m_this = nullptr;
 
 namespace {
@@ -46,10 +52,16 @@ uint8_t TestDriver::keyboard_leds(void) {
 
 void TestDriver::send_keyboard(report_keyboard_t* report) {
     test_logger.trace() << *report;
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report_sent();
+#endif
     m_this->send_keyboard_mock(*report);
 }
 
 void TestDriver::send_nkro(report_nkro_t* report) {
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report_sent();
+#endif
     m_this->send_nkro_mock(*report);
 }
 
@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Room for the VIA config, the default dynamic keymap layers and macros
+#define EEPROM_TEST_HARNESS_SIZE 1024
+
+#define DYNAMIC_KEYMAP_RAM_MIRROR
+#define VIA_STREAM_WINDOW 4
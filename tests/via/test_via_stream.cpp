@@ -0,0 +1,189 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "crc.h"
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+#include "raw_hid.h"
+#include "via.h"
+}
+
+#define REPORT_SIZE 32
+#define PAYLOAD_SIZE (REPORT_SIZE - 2)
+
+static std::vector<std::vector<uint8_t>> replies;
+
+extern "C" void raw_hid_send(uint8_t *data, uint8_t length) {
+    replies.emplace_back(data, data + length);
+}
+
+class ViaStream : public TestFixture {
+   public:
+    ViaStream() {
+        replies.clear();
+    }
+
+    ~ViaStream() {
+        dynamic_keymap_end_transaction(false);
+    }
+
+    static std::vector<uint8_t> send(std::vector<uint8_t> report) {
+        report.resize(REPORT_SIZE);
+        replies.clear();
+        raw_hid_receive(report.data(), REPORT_SIZE);
+        return replies.empty() ? std::vector<uint8_t>() : replies.back();
+    }
+
+    static std::vector<uint8_t> begin(uint8_t region, uint16_t offset, uint16_t size) {
+        return send({id_dynamic_keymap_stream_begin, region, (uint8_t)(offset >> 8), (uint8_t)(offset & 0xFF), (uint8_t)(size >> 8), (uint8_t)(size & 0xFF)});
+    }
+
+    static std::vector<uint8_t> data(uint8_t sequence, const std::vector<uint8_t> &payload) {
+        std::vector<uint8_t> report = {id_dynamic_keymap_stream_data, sequence};
+        report.insert(report.end(), payload.begin(), payload.end());
+        return send(report);
+    }
+
+    static std::vector<uint8_t> end(uint8_t crc) {
+        return send({id_dynamic_keymap_stream_end, crc});
+    }
+
+    // Keymap data for the first keys of layer 0, all set to keycode
+    static std::vector<uint8_t> keys(size_t count, uint16_t keycode) {
+        std::vector<uint8_t> payload;
+        for (size_t i = 0; i < count; i++) {
+            payload.push_back(keycode >> 8);
+            payload.push_back(keycode & 0xFF);
+        }
+        return payload;
+    }
+
+    static uint16_t stored_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+        uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+        return eeprom_read_byte(address) << 8 | eeprom_read_byte(address + 1);
+    }
+};
+
+TEST_F(ViaStream, AdvertisesStreamSupport) {
+    auto reply = send({id_get_keyboard_value, id_stream_info});
+
+    EXPECT_EQ(reply[0], id_get_keyboard_value);
+    EXPECT_EQ(reply[1], id_stream_info);
+    EXPECT_EQ(reply[2], VIA_STREAM_WINDOW);
+    EXPECT_EQ(reply[3], PAYLOAD_SIZE);
+}
+
+TEST_F(ViaStream, CommitsKeymapWhenCrcMatches) {
+    dynamic_keymap_set_keycode(0, 0, 0, KC_A);
+    dynamic_keymap_set_keycode(0, 0, 1, KC_A);
+    dynamic_keymap_flush();
+
+    auto payload = keys(2, KC_B);
+    auto reply   = begin(id_stream_keymap, 0, payload.size());
+    EXPECT_EQ(reply[1], id_stream_ok);
+    EXPECT_EQ(reply[2], VIA_STREAM_WINDOW);
+    EXPECT_EQ(reply[3], PAYLOAD_SIZE);
+
+    // The last data report is acknowledged
+    reply = data(0, payload);
+    EXPECT_EQ(reply[0], id_dynamic_keymap_stream_data);
+    EXPECT_EQ(reply[1], id_stream_ok);
+    EXPECT_EQ(reply[2], 1);
+
+    // Nothing changes until the transfer is committed
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_A);
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_A);
+
+    reply = end(crc8(payload.data(), payload.size()));
+    EXPECT_EQ(reply[1], id_stream_ok);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_B);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_B);
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_B);
+    EXPECT_EQ(stored_keycode(0, 0, 1), KC_B);
+}
+
+TEST_F(ViaStream, RollsBackOnCrcMismatch) {
+    dynamic_keymap_set_keycode(0, 0, 0, KC_A);
+    dynamic_keymap_flush();
+
+    auto payload = keys(1, KC_B);
+    begin(id_stream_keymap, 0, payload.size());
+    data(0, payload);
+
+    auto reply = end(crc8(payload.data(), payload.size()) ^ 0x01);
+    EXPECT_EQ(reply[1], id_stream_crc_mismatch);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_A);
+    EXPECT_FALSE(dynamic_keymap_in_transaction());
+}
+
+TEST_F(ViaStream, AcknowledgesOncePerWindow) {
+    auto payload = keys(PAYLOAD_SIZE / 2 * (VIA_STREAM_WINDOW + 1), KC_C);
+    begin(id_stream_keymap, 0, payload.size());
+
+    uint8_t sequence = 0;
+    for (size_t offset = 0; offset < payload.size(); offset += PAYLOAD_SIZE, sequence++) {
+        auto reply = data(sequence, std::vector<uint8_t>(payload.begin() + offset, payload.begin() + offset + PAYLOAD_SIZE));
+        if (sequence + 1 == VIA_STREAM_WINDOW || offset + PAYLOAD_SIZE == payload.size()) {
+            ASSERT_FALSE(reply.empty());
+            EXPECT_EQ(reply[1], id_stream_ok);
+            EXPECT_EQ(reply[2], sequence + 1);
+        } else {
+            EXPECT_TRUE(reply.empty());
+        }
+    }
+
+    EXPECT_EQ(end(crc8(payload.data(), payload.size()))[1], id_stream_ok);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_C);
+}
+
+TEST_F(ViaStream, AsksOnceForMissingReport) {
+    auto payload = keys(PAYLOAD_SIZE, KC_D);
+    begin(id_stream_keymap, 0, payload.size());
+    data(0, std::vector<uint8_t>(payload.begin(), payload.begin() + PAYLOAD_SIZE));
+
+    auto reply = data(2, std::vector<uint8_t>(payload.begin() + 2 * PAYLOAD_SIZE, payload.end()));
+    ASSERT_FALSE(reply.empty());
+    EXPECT_EQ(reply[1], id_stream_out_of_sequence);
+    EXPECT_EQ(reply[2], 1);
+
+    // Reports after the gap are dropped without another reply
+    EXPECT_TRUE(data(3, keys(PAYLOAD_SIZE / 2, KC_D)).empty());
+
+    data(1, std::vector<uint8_t>(payload.begin() + PAYLOAD_SIZE, payload.begin() + 2 * PAYLOAD_SIZE));
+    reply = data(2, std::vector<uint8_t>(payload.begin() + 2 * PAYLOAD_SIZE, payload.end()));
+    EXPECT_EQ(reply[1], id_stream_ok);
+    EXPECT_EQ(reply[2], 3);
+
+    EXPECT_EQ(end(crc8(payload.data(), payload.size()))[1], id_stream_ok);
+}
+
+TEST_F(ViaStream, OtherCommandsAbandonTheTransfer) {
+    dynamic_keymap_set_keycode(0, 0, 0, KC_A);
+    dynamic_keymap_flush();
+
+    auto payload = keys(1, KC_B);
+    begin(id_stream_keymap, 0, payload.size());
+    data(0, payload);
+
+    auto reply = send({id_dynamic_keymap_get_keycode, 0, 0, 0});
+    EXPECT_EQ(reply[4] << 8 | reply[5], KC_A);
+
+    EXPECT_EQ(end(crc8(payload.data(), payload.size()))[1], id_stream_not_started);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_A);
+    EXPECT_EQ(stored_keycode(0, 0, 0), KC_A);
+}
+
+TEST_F(ViaStream, RejectsRegionsOutOfBounds) {
+    auto reply = begin(id_stream_macros, dynamic_keymap_macro_get_buffer_size() - 1, 2);
+    EXPECT_EQ(reply[1], id_stream_invalid);
+    EXPECT_FALSE(dynamic_keymap_in_transaction());
+}
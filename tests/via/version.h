@@ -0,0 +1,8 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// Stands in for the version.h generated for keyboard builds, which VIA uses
+// to tell firmware builds apart
+#define QMK_BUILDDATE "2024-01-01-00:00:00"
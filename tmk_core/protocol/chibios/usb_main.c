@@ -45,6 +45,10 @@
 #include "usb_driver.h"
 #include "usb_types.h"
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
 
@@ -858,11 +862,17 @@ void send_keyboard(report_keyboard_t *report) {
     }
 
     keyboard_report_sent = *report;
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report_sent();
+#endif
 }
 
 void send_nkro(report_nkro_t *report) {
 #ifdef NKRO_ENABLE
     send_report(SHARED_IN_EPNUM, report, sizeof(report_nkro_t));
+#    ifdef LATENCY_TRACE_ENABLE
+    latency_trace_report_sent();
+#    endif
 #endif
 }
 
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "host.h"
 #include "util.h"
 #include "debug.h"
+#include "latency_trace.h"
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -84,7 +85,7 @@ void host_keyboard_send(report_keyboard_t *report) {
 #ifdef KEYBOARD_SHARED_EP
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
-    (*driver->send_keyboard)(report);
+    LATENCY_TRACE(LATENCY_TRACE_HOST_KEYBOARD_SEND, (*driver->send_keyboard)(report));
 
     if (debug_keyboard) {
         dprintf("keyboard_report: %02X | ", report->mods);